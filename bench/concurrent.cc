@@ -0,0 +1,49 @@
+//
+// Multi-threaded emission throughput, comparing signal<> (which holds its lock while
+// running slots) against concurrent_signal<> (which takes no lock to emit).
+//
+
+#include <benchmark/benchmark.h>
+#include <sigslot/sigslot.h>
+#include <sigslot/concurrent.h>
+#include <atomic>
+
+namespace {
+    // Each slot does a little independent work, as real slots would; the point is whether
+    // that work can proceed on several cores at once.
+    class Sink : public sigslot::has_slots {
+    public:
+        void slot(int i) {
+            thread_local unsigned long state = 1;
+            for (int n = 0; n != 64; ++n) state = state * 6364136223846793005UL + i;
+            benchmark::DoNotOptimize(state);
+        }
+    };
+
+    constexpr int slots = 8;
+
+    template<typename Signal>
+    struct fixture {
+        Sink sinks[slots];
+        Signal signal;
+
+        fixture() {
+            for (auto & sink : sinks) signal.template connect<&Sink::slot>(&sink);
+        }
+    };
+}
+
+template<typename Signal>
+static void BM_emit_threads(benchmark::State & state) {
+    static fixture<Signal> * f;
+    if (state.thread_index() == 0) f = new fixture<Signal>;
+    for (auto _ : state) {
+        f->signal(1);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete f;
+    }
+}
+BENCHMARK_TEMPLATE(BM_emit_threads, sigslot::signal<int>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_emit_threads, sigslot::concurrent_signal<int>)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,108 @@
+//
+// Coroutine overheads: awaiting a signal, creating and running a tasklet, and chains of
+// tasklets each awaiting the next. These use the built-in resumption, which resumes
+// directly from the emitting thread.
+//
+
+#include <benchmark/benchmark.h>
+#include <sigslot/sigslot.h>
+#include <sigslot/tasklet.h>
+#include <string>
+
+namespace {
+    sigslot::tasklet<void> await_forever(sigslot::signal<int> & signal, long & total) {
+        for (;;) {
+            total += co_await signal;
+        }
+    }
+
+    sigslot::tasklet<int> await_once(sigslot::signal<int> & signal) {
+        co_return co_await signal;
+    }
+
+    sigslot::tasklet<int> trivial(int i) {
+        co_return i;
+    }
+
+    sigslot::tasklet<int> chain(int depth) {
+        if (depth == 0) co_return 0;
+        co_return 1 + co_await chain(depth - 1);
+    }
+
+    sigslot::tasklet<std::string> await_string(sigslot::signal<std::string const &> & signal) {
+        co_return co_await signal;
+    }
+}
+
+// Each emission resumes the coroutine, which loops round to await the signal again, so
+// this is the cost of the awaitable's connection, the emission, and the resumption.
+static void BM_co_await_signal(benchmark::State & state) {
+    sigslot::signal<int> signal;
+    long total = 0;
+    auto task = await_forever(signal, total);
+    task.start();
+    for (auto _ : state) {
+        signal(1);
+    }
+    benchmark::DoNotOptimize(total);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_co_await_signal);
+
+// As above, but with a new tasklet for every emission.
+static void BM_co_await_signal_tasklet(benchmark::State & state) {
+    sigslot::signal<int> signal;
+    for (auto _ : state) {
+        auto task = await_once(signal);
+        task.start();
+        signal(1);
+        benchmark::DoNotOptimize(task.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_co_await_signal_tasklet);
+
+// The awaitable copies its result out of the emission.
+static void BM_co_await_signal_string(benchmark::State & state) {
+    sigslot::signal<std::string const &> signal;
+    std::string const payload(state.range(0), 'x');
+    for (auto _ : state) {
+        auto task = await_string(signal);
+        task.start();
+        signal(payload);
+        benchmark::DoNotOptimize(task.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_co_await_signal_string)->Arg(8)->Arg(256);
+
+static void BM_tasklet_create(benchmark::State & state) {
+    for (auto _ : state) {
+        auto task = trivial(1);
+        benchmark::DoNotOptimize(task);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_tasklet_create);
+
+static void BM_tasklet_run(benchmark::State & state) {
+    for (auto _ : state) {
+        auto task = trivial(1);
+        benchmark::DoNotOptimize(task.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_tasklet_run);
+
+// range(0) tasklets, each awaiting the next.
+static void BM_tasklet_chain(benchmark::State & state) {
+    auto depth = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        auto task = chain(depth);
+        benchmark::DoNotOptimize(task.get());
+    }
+    state.counters["per_await"] = benchmark::Counter(
+            static_cast<double>(state.iterations() * state.range(0)),
+            benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_tasklet_chain)->Arg(1)->Arg(8)->Arg(64);
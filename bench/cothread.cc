@@ -0,0 +1,61 @@
+//
+// co_thread spawn latency: from a tasklet calling the co_thread to it being resumed with
+// the result. co_thread needs an event loop to resume the awaiting coroutine on, so this
+// is built on its own, with a minimal one.
+//
+
+#include <benchmark/benchmark.h>
+#include <coroutine>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <sigslot/resume.h>
+
+namespace {
+    std::mutex queue_mutex;
+    std::vector<std::coroutine_handle<>> queue;
+}
+
+namespace sigslot {
+    void resume(std::coroutine_handle<> coro) {
+        std::scoped_lock lock(queue_mutex);
+        queue.push_back(coro);
+    }
+}
+
+#include <sigslot/sigslot.h>
+#include <sigslot/tasklet.h>
+#include <sigslot/cothread.h>
+
+namespace {
+    template<typename R>
+    R run(sigslot::tasklet<R> & task) {
+        task.start();
+        std::vector<std::coroutine_handle<>> current;
+        while (task.running()) {
+            {
+                std::scoped_lock lock(queue_mutex);
+                current.swap(queue);
+            }
+            for (auto coro : current) coro.resume();
+            current.clear();
+        }
+        return task.get();
+    }
+
+    sigslot::tasklet<int> spawn(int i) {
+        sigslot::co_thread thread([](int i) {
+            return i;
+        });
+        co_return co_await thread(std::as_const(i));
+    }
+}
+
+static void BM_co_thread(benchmark::State & state) {
+    for (auto _ : state) {
+        auto task = spawn(1);
+        benchmark::DoNotOptimize(run(task));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_co_thread)->UseRealTime();
@@ -0,0 +1,202 @@
+//
+// Emission cost per slot, for the flat slot vector against the std::list of
+// heap-allocated connections that signal<> used to have, the cost of passing arguments
+// by value against by reference, and the cost of a batch of
+// events emitted one at a time against emit_many(), and of routing a message through a
+// signal whose combiner stops at the first slot to claim it.
+//
+
+#include <benchmark/benchmark.h>
+#include <sigslot/sigslot.h>
+#include <list>
+#include <memory>
+
+namespace {
+    class Sink : public sigslot::has_slots {
+    public:
+        long count = 0;
+        void slot(int i) {
+            count += i;
+        }
+    };
+
+    // A copy of the storage and emission loop signal<> had before it went flat: a std::list
+    // of individually allocated connections, each wrapping a std::function. (It used to
+    // keep has_slots bookkeeping, and re-register every slot after each emit, too, but
+    // that's left out to compare just the storage; the sinks outlive it.)
+    class list_signal {
+        struct connection {
+            sigslot::has_slots * dest;
+            std::function<void(int)> fn;
+            bool one_shot = false;
+            bool expired = false;
+        };
+        std::recursive_mutex m_barrier;
+        std::list<connection *> m_connected_slots;
+    public:
+        ~list_signal() {
+            for (auto i : m_connected_slots) delete i;
+        }
+        void connect(Sink * sink) {
+            std::scoped_lock lock(m_barrier);
+            m_connected_slots.push_back(new connection{sink, [sink](int i) { sink->slot(i); }});
+        }
+        void emit(int i) {
+            std::scoped_lock lock(m_barrier);
+            for (auto conn : m_connected_slots) {
+                if (conn->one_shot) conn->expired = true;
+                conn->fn(i);
+            }
+            m_connected_slots.remove_if([](connection * x) {
+                if (x->expired) {
+                    delete x;
+                    return true;
+                }
+                return false;
+            });
+        }
+    };
+
+    // Interleave the sinks with some other allocations, so they're scattered about the heap
+    // much as they would be in a real program.
+    std::vector<std::unique_ptr<Sink>> make_sinks(std::size_t n) {
+        std::vector<std::unique_ptr<Sink>> sinks;
+        std::vector<std::unique_ptr<char[]>> chaff;
+        for (std::size_t i = 0; i != n; ++i) {
+            sinks.push_back(std::make_unique<Sink>());
+            chaff.push_back(std::make_unique<char[]>(96));
+        }
+        return sinks;
+    }
+
+    void set_counters(benchmark::State & state) {
+        state.counters["per_slot"] = benchmark::Counter(
+            static_cast<double>(state.iterations() * state.range(0)),
+            benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    }
+}
+
+static void BM_emit_flat(benchmark::State & state) {
+    auto sinks = make_sinks(state.range(0));
+    sigslot::signal<int> signal;
+    for (auto & sink : sinks) signal.connect(sink.get(), &Sink::slot);
+    for (auto _ : state) {
+        signal(1);
+    }
+    set_counters(state);
+}
+BENCHMARK(BM_emit_flat)->Arg(1)->Arg(8)->Arg(64)->Arg(1024);
+
+static void BM_emit_flat_bound(benchmark::State & state) {
+    auto sinks = make_sinks(state.range(0));
+    sigslot::signal<int> signal;
+    for (auto & sink : sinks) signal.connect<&Sink::slot>(sink.get());
+    for (auto _ : state) {
+        signal(1);
+    }
+    set_counters(state);
+}
+BENCHMARK(BM_emit_flat_bound)->Arg(1)->Arg(8)->Arg(64)->Arg(1024);
+
+static void BM_emit_single_threaded(benchmark::State & state) {
+    class StSink : public sigslot::st::has_slots {
+    public:
+        long count = 0;
+        void slot(int i) {
+            count += i;
+        }
+    };
+    std::vector<std::unique_ptr<StSink>> sinks;
+    for (long i = 0; i != state.range(0); ++i) sinks.push_back(std::make_unique<StSink>());
+    sigslot::st::signal<int> signal;
+    for (auto & sink : sinks) signal.connect<&StSink::slot>(sink.get());
+    for (auto _ : state) {
+        signal(1);
+    }
+    set_counters(state);
+}
+BENCHMARK(BM_emit_single_threaded)->Arg(1)->Arg(8)->Arg(64)->Arg(1024);
+
+static void BM_emit_list(benchmark::State & state) {
+    auto sinks = make_sinks(state.range(0));
+    list_signal signal;
+    for (auto & sink : sinks) signal.connect(sink.get());
+    for (auto _ : state) {
+        signal.emit(1);
+    }
+    set_counters(state);
+}
+BENCHMARK(BM_emit_list)->Arg(1)->Arg(8)->Arg(64)->Arg(1024);
+
+// A string argument to range(0) slots: a by-value signal copies it for each slot but the
+// last, which may have it moved, where a reference signal passes it straight through.
+template<typename Arg>
+static void BM_emit_string(benchmark::State & state) {
+    long count = 0;
+    sigslot::signal<Arg> signal;
+    std::vector<sigslot::scoped_connection> connections;
+    for (long i = 0; i != state.range(0); ++i) {
+        connections.push_back(signal.connect([&count](Arg s) { count += static_cast<long>(s.size()); }));
+    }
+    std::string const payload(64, 'x');
+    for (auto _ : state) {
+        signal(payload);
+    }
+    benchmark::DoNotOptimize(count);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_emit_string, std::string)->Arg(0)->Arg(1)->Arg(8);
+BENCHMARK_TEMPLATE(BM_emit_string, std::string const &)->Arg(0)->Arg(1)->Arg(8);
+
+// A batch of 256 events to 8 slots, one emit() at a time, and with emit_many().
+static void BM_emit_batch_loop(benchmark::State & state) {
+    auto sinks = make_sinks(8);
+    sigslot::signal<int> signal;
+    for (auto & sink : sinks) signal.connect<&Sink::slot>(sink.get());
+    std::vector<int> events(256, 1);
+    for (auto _ : state) {
+        for (auto i : events) signal(i);
+    }
+    state.SetItemsProcessed(state.iterations() * events.size());
+}
+BENCHMARK(BM_emit_batch_loop);
+
+static void BM_emit_batch_many(benchmark::State & state) {
+    auto sinks = make_sinks(8);
+    sigslot::signal<int> signal;
+    for (auto & sink : sinks) signal.connect<&Sink::slot>(sink.get());
+    std::vector<int> events(256, 1);
+    auto order = static_cast<sigslot::emit_order>(state.range(0));
+    for (auto _ : state) {
+        signal.emit_many(events, order);
+    }
+    state.SetItemsProcessed(state.iterations() * events.size());
+}
+BENCHMARK(BM_emit_batch_many)->Arg(static_cast<int>(sigslot::emit_order::slot_major))->Arg(static_cast<int>(sigslot::emit_order::event_major));
+
+// Routing a message to the one of 200 handlers that claims it, with the claiming handler
+// at the position given: a plain signal has to call every slot, where first_non_empty
+// stops at the claim.
+static void BM_route_all(benchmark::State & state) {
+    sigslot::signal<int> signal;
+    int claimed = -1;
+    for (int h = 0; h != 200; ++h) {
+        (void) signal.connect(nullptr, [h, &claimed](int msg) { if (msg == h) claimed = h; });
+    }
+    for (auto _ : state) {
+        signal(static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(claimed);
+    }
+}
+BENCHMARK(BM_route_all)->Arg(0)->Arg(100);
+
+static void BM_route_first(benchmark::State & state) {
+    sigslot::signal<bool(int)> signal;
+    for (int h = 0; h != 200; ++h) {
+        (void) signal.connect(nullptr, [h](int msg) { return msg == h; });
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(signal.emit<sigslot::combiners::first_non_empty>(static_cast<int>(state.range(0))));
+    }
+}
+BENCHMARK(BM_route_first)->Arg(0)->Arg(100);
@@ -0,0 +1,81 @@
+//
+// The cost of making and breaking connections: connecting and disconnecting a slot on a
+// signal that already has others, a scoped_connection coming and going, and a has_slots
+// being destroyed while connected to many signals.
+//
+
+#include <benchmark/benchmark.h>
+#include <sigslot/sigslot.h>
+#include <memory>
+#include <vector>
+
+namespace {
+    class Sink : public sigslot::has_slots {
+    public:
+        long count = 0;
+        void slot(int i) {
+            count += i;
+        }
+    };
+}
+
+// One slot connected and disconnected again, on a signal with range(0) others.
+static void BM_connect_churn(benchmark::State & state) {
+    std::vector<Sink> others(state.range(0));
+    Sink sink;
+    sigslot::signal<int> signal;
+    for (auto & other : others) signal.connect<&Sink::slot>(&other);
+    for (auto _ : state) {
+        auto conn = signal.connect<&Sink::slot>(&sink);
+        conn.disconnect();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_connect_churn)->Arg(0)->Arg(8)->Arg(64)->Arg(1024);
+
+// As above, but the has_slots disconnects everything it has.
+static void BM_connect_churn_has_slots(benchmark::State & state) {
+    std::vector<Sink> others(state.range(0));
+    Sink sink;
+    sigslot::signal<int> signal;
+    for (auto & other : others) signal.connect<&Sink::slot>(&other);
+    for (auto _ : state) {
+        signal.connect<&Sink::slot>(&sink);
+        sink.disconnect_all();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_connect_churn_has_slots)->Arg(0)->Arg(8)->Arg(64)->Arg(1024);
+
+static void BM_connect_churn_scoped(benchmark::State & state) {
+    sigslot::signal<int> signal;
+    long count = 0;
+    for (auto _ : state) {
+        sigslot::scoped_connection conn = signal.connect([&count](int i) { count += i; });
+        benchmark::DoNotOptimize(conn);
+    }
+    benchmark::DoNotOptimize(count);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_connect_churn_scoped);
+
+// A has_slots connected to range(0) signals, each with a few other slots, being destroyed.
+// Connecting it again is excluded from the timing.
+static void BM_has_slots_destroy(benchmark::State & state) {
+    std::vector<Sink> others(4);
+    std::vector<sigslot::signal<int>> signals(state.range(0));
+    for (auto & signal : signals) {
+        for (auto & other : others) signal.connect<&Sink::slot>(&other);
+    }
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto sink = std::make_unique<Sink>();
+        for (auto & signal : signals) signal.connect<&Sink::slot>(sink.get());
+        state.ResumeTiming();
+        sink.reset();
+    }
+    state.counters["per_signal"] = benchmark::Counter(
+            static_cast<double>(state.iterations() * state.range(0)),
+            benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_has_slots_destroy)->Arg(1)->Arg(16)->Arg(256)->Arg(4096);
@@ -0,0 +1,215 @@
+//
+// Contention and scalability: many threads at once emitting, connecting, disconnecting
+// and destroying has_slots, on a shared set of signals, so that signal and has_slots locks
+// are taken in both orders. For each thread count, reports total throughput and the
+// latency of each kind of operation.
+//
+// Any deadlock shows up as a step that doesn't finish, at which point the process aborts
+// (under a debugger, or ThreadSanitizer, that's where to look). Configure with
+// -DSIGSLOT_SANITIZE=thread to build this - and the tests - with ThreadSanitizer.
+//
+// Usage: sigslot-stress [--threads N] [--seconds S] [--signals K] [--sinks M]
+//
+
+#include <sigslot/sigslot.h>
+#include <sigslot/concurrent.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    struct options {
+        unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+        double seconds = 1.0;
+        std::size_t signals = 16;
+        std::size_t sinks = 4;
+    };
+
+    enum op { emit, connect, disconnect, destroy, ops };
+    constexpr char const * op_names[ops] = {"emit", "connect", "disconnect", "destroy"};
+
+    class Sink : public sigslot::has_slots {
+    public:
+        std::atomic<long> count{0};
+        void slot(int i) {
+            count.fetch_add(i, std::memory_order_relaxed);
+        }
+        // Slots are still reachable until has_slots' destructor runs, which is after
+        // count has gone; disconnecting here avoids them touching it.
+        ~Sink() {
+            disconnect_all();
+        }
+    };
+
+    // Per-thread, so the operations themselves are all that's contended.
+    struct xorshift {
+        std::uint64_t state;
+        std::uint64_t operator()() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+    };
+
+    struct results {
+        sigslot::latency_histogram latency[ops];
+    };
+
+    template<typename Signal>
+    class step {
+    public:
+        step(options const & o, unsigned threads) : m_options(o), m_signals(o.signals), m_results(threads), m_start(clock::now()) {
+            for (unsigned t = 0; t != threads; ++t) {
+                m_threads.emplace_back([this, t]() { run(t); });
+            }
+        }
+
+        // Returns false if the threads failed to stop, which can only be a deadlock.
+        bool finish(std::chrono::duration<double> timeout)
+        {
+            m_stop.store(true);
+            m_elapsed = clock::now() - m_start;
+            std::unique_lock lock(m_mutex);
+            if (!m_done.wait_for(lock, timeout, [this]() { return m_finished == m_threads.size(); })) return false;
+            lock.unlock();
+            for (auto & thread : m_threads) thread.join();
+            return true;
+        }
+
+        [[nodiscard]] double seconds() const
+        {
+            return std::chrono::duration<double>(m_elapsed).count();
+        }
+
+        results total() const
+        {
+            results r;
+            for (auto const & each : m_results) {
+                for (int o = 0; o != ops; ++o) r.latency[o].merge(each.latency[o]);
+            }
+            return r;
+        }
+
+    private:
+        void attach(Sink * sink, xorshift & random)
+        {
+            for (int n = 0; n != 4; ++n) m_signals[random() % m_signals.size()].template connect<&Sink::slot>(sink);
+        }
+
+        void run(unsigned t)
+        {
+            xorshift random{0x9E3779B97F4A7C15ull * (t + 1)};
+            auto & latency = m_results[t].latency;
+            std::vector<std::unique_ptr<Sink>> sinks;
+            for (std::size_t n = 0; n != m_options.sinks; ++n) {
+                sinks.push_back(std::make_unique<Sink>());
+                attach(sinks.back().get(), random);
+            }
+            while (!m_stop.load(std::memory_order_relaxed)) {
+                auto r = random();
+                auto & signal = m_signals[(r >> 8) % m_signals.size()];
+                auto & sink = sinks[(r >> 32) % sinks.size()];
+                // Mostly emitting, as in most programs; connect and disconnect balance out.
+                auto which = r % 20;
+                op o = which < 14 ? emit : which < 16 ? connect : which < 18 ? disconnect : destroy;
+                auto start = clock::now();
+                switch (o) {
+                    case emit:
+                        signal(1);
+                        break;
+                    case connect:
+                        signal.template connect<&Sink::slot>(sink.get());
+                        break;
+                    case disconnect:
+                        signal.disconnect(sink.get());
+                        break;
+                    default:
+                        sink.reset();
+                        sink = std::make_unique<Sink>();
+                        attach(sink.get(), random);
+                        break;
+                }
+                latency[o].record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count()));
+            }
+            sinks.clear();
+            std::scoped_lock lock(m_mutex);
+            ++m_finished;
+            m_done.notify_all();
+        }
+
+        options const & m_options;
+        std::vector<Signal> m_signals;
+        std::vector<results> m_results;
+        clock::time_point m_start;
+        clock::duration m_elapsed{};
+        std::atomic<bool> m_stop{false};
+        std::mutex m_mutex;
+        std::condition_variable m_done;
+        std::size_t m_finished = 0;
+        std::vector<std::thread> m_threads;
+    };
+
+    template<typename Signal>
+    void run(char const * name, options const & o)
+    {
+        std::printf("%s: %zu signals, %zu sinks per thread\n", name, o.signals, o.sinks);
+        std::printf("%8s %12s", "threads", "ops/s");
+        for (auto n : op_names) std::printf(" %10s p50 %10s p99", n, n);
+        std::printf("\n");
+        for (unsigned threads = 1;; threads = std::min(threads * 2, o.threads)) {
+            auto s = std::make_unique<step<Signal>>(o, threads);
+            std::this_thread::sleep_for(std::chrono::duration<double>(o.seconds));
+            if (!s->finish(std::chrono::duration<double>(10 + 10 * o.seconds))) {
+                std::fprintf(stderr, "%s: %u threads failed to stop - deadlocked?\n", name, threads);
+                std::abort();
+            }
+            auto r = s->total();
+            std::uint64_t count = 0;
+            for (auto const & l : r.latency) count += l.count();
+            std::printf("%8u %12.0f", threads, static_cast<double>(count) / s->seconds());
+            for (auto const & l : r.latency) {
+                std::printf(" %12.2fus %12.2fus", static_cast<double>(l.percentile(0.5)) / 1000.0, static_cast<double>(l.percentile(0.99)) / 1000.0);
+            }
+            std::printf("\n");
+            if (threads == o.threads) break;
+        }
+        std::printf("\n");
+    }
+
+    bool parse(int argc, char ** argv, options & o)
+    {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            if (!std::strcmp(argv[i], "--threads")) o.threads = static_cast<unsigned>(std::max(1l, std::atol(argv[i + 1])));
+            else if (!std::strcmp(argv[i], "--seconds")) o.seconds = std::max(0.01, std::atof(argv[i + 1]));
+            else if (!std::strcmp(argv[i], "--signals")) o.signals = static_cast<std::size_t>(std::max(1l, std::atol(argv[i + 1])));
+            else if (!std::strcmp(argv[i], "--sinks")) o.sinks = static_cast<std::size_t>(std::max(1l, std::atol(argv[i + 1])));
+            else return false;
+        }
+        return argc % 2 == 1;
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    options o;
+    if (!parse(argc, argv, o)) {
+        std::fprintf(stderr, "Usage: %s [--threads N] [--seconds S] [--signals K] [--sinks M]\n", argv[0]);
+        return 2;
+    }
+    run<sigslot::signal<int>>("signal", o);
+    run<sigslot::concurrent_signal<int>>("concurrent_signal", o);
+    return 0;
+}
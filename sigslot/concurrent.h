@@ -0,0 +1,432 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#ifndef SIGSLOT_CONCURRENT_H
+#define SIGSLOT_CONCURRENT_H
+
+#include <sigslot/sigslot.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace sigslot {
+    namespace internal {
+        // Epoch-based reclamation, as used by concurrent_signal.
+        //
+        // Each thread has a record saying which epoch it entered its outermost emission in,
+        // or zero when it's not emitting. Writers stamp anything they unpublish with the
+        // epoch current at the time, and only free it once no thread is still emitting in
+        // that epoch or an earlier one. Entering and leaving an emission only touches the
+        // thread's own record, so emitters on different threads don't contend.
+        class _epoch {
+        public:
+            struct record {
+                std::atomic<std::uint64_t> active{0};
+                unsigned nesting = 0;
+                record * prev = nullptr;
+                record * next = nullptr;
+
+                record()
+                {
+                    std::scoped_lock lock(s_mutex);
+                    next = s_records;
+                    if (next) next->prev = this;
+                    s_records = this;
+                }
+
+                ~record()
+                {
+                    std::scoped_lock lock(s_mutex);
+                    if (prev) prev->next = next; else s_records = next;
+                    if (next) next->prev = prev;
+                }
+            };
+
+            class guard {
+            public:
+                guard() : m_record(local())
+                {
+                    if (m_record.nesting++ == 0) {
+                        m_record.active.store(s_global.load());
+                    }
+                }
+                guard(guard const &) = delete;
+
+                ~guard()
+                {
+                    if (--m_record.nesting == 0) {
+                        m_record.active.store(0, std::memory_order_release);
+                    }
+                }
+
+            private:
+                record & m_record;
+            };
+
+            static record & local()
+            {
+                thread_local record r;
+                return r;
+            }
+
+            // Call after unpublishing something; returns the epoch to retire it with.
+            static std::uint64_t advance()
+            {
+                return s_global.fetch_add(1);
+            }
+
+            // True if nothing retired in epoch e (or earlier) can still be in use.
+            static bool quiescent(std::uint64_t e)
+            {
+                std::scoped_lock lock(s_mutex);
+                for (auto r = s_records; r; r = r->next) {
+                    auto a = r->active.load();
+                    if (a != 0 && a <= e) return false;
+                }
+                return true;
+            }
+
+        private:
+            static inline std::mutex s_mutex;
+            static inline record * s_records = nullptr;
+            static inline std::atomic<std::uint64_t> s_global{1};
+        };
+
+        // Counts the emissions in progress on a single signal, so that disconnecting a slot
+        // can wait for just those. Each emission counts itself in whichever of two counters
+        // is current; waiting switches counter and waits for the old one to empty, twice,
+        // so it's never held up by emissions that started after it did.
+        //
+        // Each thread also keeps a chain of the guards it holds, innermost first, so it can
+        // tell which signals it's part way through emitting.
+        class _readers {
+        public:
+            class guard {
+            public:
+                explicit guard(_readers & r) : m_readers(r), m_count(r.m_count[r.m_phase.load() & 1]), m_outer(top())
+                {
+                    m_count.fetch_add(1);
+                    top() = this;
+                }
+                guard(guard const &) = delete;
+
+                ~guard()
+                {
+                    top() = m_outer;
+                    m_count.fetch_sub(1, std::memory_order_release);
+                }
+
+            private:
+                friend class _readers;
+                _readers & m_readers;
+                std::atomic<unsigned> & m_count;
+                guard * const m_outer;
+            };
+
+            // True if this thread is part way through an emission counted here, which
+            // synchronize() would wait for forever.
+            bool entered() const
+            {
+                for (auto g = top(); g; g = g->m_outer) {
+                    if (&g->m_readers == this) return true;
+                }
+                return false;
+            }
+
+            // Waits until every emission that might have seen something already unpublished
+            // has finished.
+            void synchronize()
+            {
+                std::scoped_lock lock(m_mutex);
+                for (int i = 0; i != 2; ++i) {
+                    auto old = m_phase.fetch_xor(1) & 1;
+                    while (m_count[old].load(std::memory_order_acquire)) std::this_thread::yield();
+                }
+            }
+
+        private:
+            static guard *& top()
+            {
+                thread_local guard * t_top = nullptr;
+                return t_top;
+            }
+
+            std::atomic<unsigned> m_phase{0};
+            std::atomic<unsigned> m_count[2]{};
+            std::mutex m_mutex;
+        };
+    }
+
+    // A signal whose emission takes no locks.
+    //
+    // The connected slots are kept as an immutable snapshot. emit() picks up the current
+    // snapshot and runs through it without holding m_barrier, so any number of threads can
+    // emit at once, and a slow slot doesn't hold up connect or disconnect on other threads.
+    // Connecting and disconnecting copy the snapshot, change the copy, and publish it;
+    // the old one is freed once no emission can still be using it.
+    //
+    // Emissions already running when a slot is disconnected may still call it, with one
+    // exception: when a has_slots is destroyed, its destructor waits for emissions of this
+    // signal running on other threads to finish, once it has released its own lock, so its
+    // slots are never called after it's gone. (If the has_slots is destroyed from within an
+    // emission of this signal, it cannot wait, and only emissions on the same thread are
+    // safe.) Slots may
+    // be called concurrently, and need to cope with that.
+    template<class... args>
+    class concurrent_signal : public internal::_signal_base_lo<multi_threaded_local>
+    {
+    public:
+        using has_slots_type = basic_has_slots<multi_threaded_local>;
+        using connection_handle = basic_connection<multi_threaded_local>;
+
+    private:
+        using link_type = internal::_connection_link<multi_threaded_local>;
+
+        // The link's signal pointer, cleared only with m_barrier held, says whether it's
+        // still to be detached.
+        struct node : public link_type {
+            node(concurrent_signal * s, has_slots_type * pobject, internal::_inplace_function<args...> && fn, bool once, int prio)
+                    : link_type(s, pobject), one_shot(once), priority(prio), m_readers(s->m_readers), m_fn(std::move(fn)) {}
+
+            // Shares the signal's reader count, so this works even once the signal's gone.
+            // From within an emission of this same signal, it can only skip the wait.
+            void quiesce() override
+            {
+                if (!m_readers->entered()) m_readers->synchronize();
+            }
+
+            void emit(bool consume, internal::_slot_arg<args>... a) const
+            {
+                (*m_fn)(consume, a...);
+            }
+
+            // Called once no snapshot holds the node, so no emission can be using the slot.
+            // Handles may keep the node itself for longer, but have no need of the slot.
+            void drop()
+            {
+                m_fn.reset();
+            }
+
+            const bool one_shot;
+            const int priority;
+            std::atomic<bool> live{true};
+            std::atomic<bool> skip{false};
+        private:
+            std::shared_ptr<internal::_readers> m_readers;
+            mutable std::optional<internal::_inplace_function<args...>> m_fn;
+        };
+
+        // Snapshots share nodes; the last one to let go drops the slot, and the signal's
+        // reference.
+        struct snapshot {
+            std::vector<std::shared_ptr<node>> slots;
+        };
+
+    public:
+        concurrent_signal() = default;
+        concurrent_signal(concurrent_signal const &) = delete;
+        concurrent_signal(concurrent_signal &&) = delete;
+
+        ~concurrent_signal() override
+        {
+            disconnect_all();
+            std::scoped_lock lock(m_barrier);
+            for (auto & [e, snap] : m_retired) delete snap;
+            delete m_snapshot.load();
+        }
+
+        template<typename Fn>
+        requires std::invocable<std::decay_t<Fn> &, args...>
+        connection_handle connect(has_slots_type *pclass, Fn &&fn, bool one_shot = false, priority prio = {})
+        {
+            std::shared_ptr<node> conn(
+                    new node(this, pclass, internal::_inplace_function<args...>(std::forward<Fn>(fn)), one_shot, prio.value),
+                    [](node * n) {
+                        n->drop();
+                        n->unref();
+                    });
+            connection_handle handle(conn.get());
+            std::scoped_lock lock(m_barrier);
+            if (pclass) pclass->signal_connect(conn.get());
+            auto next = copy();
+            auto pos = std::upper_bound(next->slots.begin(), next->slots.end(), prio.value,
+                                        [](int p, auto const & c) { return p > c->priority; });
+            next->slots.insert(pos, std::move(conn));
+            publish(next);
+            return handle;
+        }
+
+        // Helper for ptr-to-member; call the member function "normally".
+        template<class desttype>
+        requires std::derived_from<desttype, has_slots_type>
+        connection_handle connect(desttype *pclass, void (desttype::* memfn)(args...), bool one_shot = false, priority prio = {})
+        {
+            return this->connect(pclass, [pclass, memfn](auto &&... a) { (pclass->*memfn)(std::forward<decltype(a)>(a)...); }, one_shot, prio);
+        }
+
+        template<auto memfn, class desttype>
+        requires std::derived_from<desttype, has_slots_type> && std::invocable<decltype(memfn), desttype *, args...>
+        connection_handle connect(desttype *pclass, bool one_shot = false, priority prio = {})
+        {
+            return this->connect(pclass, [pclass](auto &&... a) { (pclass->*memfn)(std::forward<decltype(a)>(a)...); }, one_shot, prio);
+        }
+
+        // Connects a slot to be called through an executor; see basic_signal.
+        template<typename Fn, executor Executor>
+        requires std::invocable<std::decay_t<Fn> &, args...>
+        connection_handle connect(has_slots_type *pclass, Fn &&fn, Executor && exec, bool one_shot = false, priority prio = {})
+        {
+            using queued_slot = internal::_queued_slot<multi_threaded_local, std::decay_t<Fn>, Executor>;
+            auto slot = std::make_shared<queued_slot>(std::forward<Fn>(fn), std::forward<Executor>(exec),
+                                                      pclass ? pclass->liveness() : nullptr, one_shot);
+            std::scoped_lock lock{m_barrier};
+            slot->conn = this->connect(pclass, queued_slot::template trampoline<false, args...>(slot), false, prio);
+            return slot->conn;
+        }
+
+        template<class desttype, executor Executor>
+        requires std::derived_from<desttype, has_slots_type>
+        connection_handle connect(desttype *pclass, void (desttype::* memfn)(args...), Executor && exec, bool one_shot = false, priority prio = {})
+        {
+            return this->connect(pclass, [pclass, memfn](auto &&... a) { (pclass->*memfn)(std::forward<decltype(a)>(a)...); }, std::forward<Executor>(exec), one_shot, prio);
+        }
+
+        template<auto memfn, class desttype, executor Executor>
+        requires std::derived_from<desttype, has_slots_type> && std::invocable<decltype(memfn), desttype *, args...>
+        connection_handle connect(desttype *pclass, Executor && exec, bool one_shot = false, priority prio = {})
+        {
+            return this->connect(pclass, [pclass](auto &&... a) { (pclass->*memfn)(std::forward<decltype(a)>(a)...); }, std::forward<Executor>(exec), one_shot, prio);
+        }
+
+        template<typename Fn>
+        requires std::invocable<std::decay_t<Fn> &, args...>
+        [[nodiscard]] basic_scoped_connection<multi_threaded_local> connect(Fn && fn, bool one_shot=false, priority prio = {})
+        {
+            return this->connect(nullptr, std::forward<Fn>(fn), one_shot, prio);
+        }
+
+        void disconnect_all()
+        {
+            std::scoped_lock lock(m_barrier);
+            remove([](node const &) { return true; });
+        }
+
+        void disconnect(has_slots_type *pclass)
+        {
+            std::scoped_lock lock(m_barrier);
+            remove([pclass](node const & conn) { return conn.dest == pclass; });
+        }
+
+        // Only a has_slots being destroyed (or disconnecting everything) calls this. The
+        // has_slots then waits, through the link's quiesce(), for emissions in progress
+        // elsewhere to finish - but not until it has released its lock, which their slots
+        // might need.
+        bool slot_disconnect(link_type * link) final
+        {
+            return slot_update(link, internal::_slot_op::disconnect);
+        }
+
+        // Called by connection handles; unlike the above, nothing waits.
+        bool slot_update(link_type * link, internal::_slot_op op) final
+        {
+            std::unique_lock lock(m_barrier, std::try_to_lock);
+            if (!lock) return false;
+            if (op == internal::_slot_op::disconnect) {
+                remove([link](node const & conn) { return &conn == link; });
+            } else {
+                static_cast<node *>(link)->skip.store(op == internal::_slot_op::block);
+            }
+            return true;
+        }
+
+        // One-shot slots are disconnected as they're called, even if they throw.
+        void emit(args... a)
+        {
+            bool expiry = false;
+            try {
+                internal::_epoch::guard guard;
+                internal::_readers::guard readers(*m_readers);
+                auto current = m_snapshot.load();
+                if (!current) return;
+                for (auto const & conn : current->slots) {
+                    if (conn->skip.load(std::memory_order_relaxed)) continue;
+                    if (conn->one_shot) {
+                        if (!conn->live.exchange(false)) continue;
+                        expiry = true;
+                    } else if (!conn->live.load(std::memory_order_acquire)) {
+                        continue;
+                    }
+                    conn->emit(&conn == &current->slots.back(), a...);
+                }
+            } catch (...) {
+                if (expiry) expire();
+                throw;
+            }
+            if (expiry) expire();
+        }
+
+        void operator()(args... a)
+        {
+            this->emit(std::forward<args>(a)...);
+        }
+
+    private:
+        // Unpublishes the one-shots an emission has fired.
+        void expire()
+        {
+            std::scoped_lock lock(m_barrier);
+            remove([](node const & conn) { return !conn.live.load(); });
+        }
+
+        // The remaining members must be called with m_barrier held.
+
+        snapshot * copy()
+        {
+            auto current = m_snapshot.load();
+            return current ? new snapshot{current->slots} : new snapshot{};
+        }
+
+        void publish(snapshot * next)
+        {
+            auto old = m_snapshot.exchange(next);
+            if (old) m_retired.emplace_back(internal::_epoch::advance(), old);
+            std::erase_if(m_retired, [](auto const & retired) {
+                if (!internal::_epoch::quiescent(retired.first)) return false;
+                delete retired.second;
+                return true;
+            });
+        }
+
+        // Unpublishes the matching connections, and detaches them from their has_slots and
+        // handles. Fired one-shots are left in place until their emission has finished, and
+        // then unpublished by the emitter; each is detached just once.
+        template<typename Pred>
+        void remove(Pred && pred)
+        {
+            auto current = m_snapshot.load();
+            if (!current) return;
+            auto next = copy();
+            auto removed = std::erase_if(next->slots, [&pred](auto const & conn) {
+                if (!pred(*conn)) return false;
+                conn->live.store(false);
+                if (conn->signal) conn->detach();
+                return true;
+            });
+            if (!removed) {
+                delete next;
+                return;
+            }
+            publish(next);
+        }
+
+        std::shared_ptr<internal::_readers> m_readers = std::make_shared<internal::_readers>();
+        std::atomic<snapshot *> m_snapshot = nullptr;
+        std::vector<std::pair<std::uint64_t, snapshot *>> m_retired;
+    };
+}
+
+#endif //SIGSLOT_CONCURRENT_H
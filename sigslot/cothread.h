@@ -168,6 +168,25 @@ namespace sigslot {
             std::exception_ptr m_eptr;
             std::recursive_mutex m_mutex;
         };
+        // Some compilers (GCC 12, at least) copy an awaiter returned by reference from
+        // operator co_await, so hand back a trivially copyable reference wrapper instead.
+        template<typename T>
+        struct awaitable_ref {
+            awaitable<T> & guts;
+
+            bool await_ready() {
+                return guts.await_ready();
+            }
+
+            void await_suspend(std::coroutine_handle<> h) {
+                guts.await_suspend(h);
+            }
+
+            auto await_resume() {
+                return guts.await_resume();
+            }
+        };
+
         template<typename T>
         struct awaitable_ptr {
             std::unique_ptr<awaitable<T>> m_guts;
@@ -175,9 +194,9 @@ namespace sigslot {
             awaitable_ptr() : m_guts(std::make_unique<awaitable<T>>()) {}
             awaitable_ptr(awaitable_ptr &&) = default;
 
-            awaitable<T> & operator co_await() {
+            awaitable_ref<T> operator co_await() {
                 m_guts->check_await();
-                return *m_guts;
+                return {*m_guts};
             }
         };
     }
@@ -0,0 +1,271 @@
+//
+// Created by dwd on 16/10/2026.
+//
+// #define switches
+//      SIGSLOT_TASK_CAPACITY:
+//      Bytes of storage each queued call has for its slot and arguments (default is eight
+//      pointers' worth). Larger calls are allocated on the heap.
+//
+
+#ifndef SIGSLOT_DISPATCHER_H
+#define SIGSLOT_DISPATCHER_H
+
+#include <sigslot/sigslot.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#ifndef SIGSLOT_TASK_CAPACITY
+#define SIGSLOT_TASK_CAPACITY (8 * sizeof(void *))
+#endif
+
+namespace sigslot {
+    // What a dispatcher does with a call posted while its queue is full.
+    enum class backpressure {
+        block,  // Wait for the dispatching thread to make room (but see post_nowait()).
+        drop,   // Discard the call, and count it in dropped().
+        grow,   // Keep it in an overflow list until there's room, and count it in overflowed().
+    };
+
+    // A queue of calls, made whenever its owner calls dispatch() - typically from an event
+    // loop. It's an executor, so connecting a slot with one, as in
+    // signal.connect(&obj, &Obj::slot, queue), makes emission copy (or move) the arguments
+    // into a call posted to the queue, instead of calling the slot there and then.
+    //
+    // Any number of threads can post at once; the queue is a bounded ring, and posting to it
+    // takes no lock (unless it's full, and the call goes to the overflow list). Only one
+    // thread at a time may dispatch.
+    class dispatcher
+    {
+    public:
+        using task = internal::_basic_inplace_function<SIGSLOT_TASK_CAPACITY, void>;
+
+        // The capacity is rounded up to a power of two.
+        explicit dispatcher(std::size_t capacity = 1024, backpressure policy = backpressure::block)
+                : m_policy(policy)
+        {
+            std::size_t size = 2;
+            while (size < capacity) size <<= 1;
+            m_mask = size - 1;
+            m_cells = std::make_unique<cell[]>(size);
+            for (std::size_t i = 0; i != size; ++i) m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        dispatcher(dispatcher const &) = delete;
+        dispatcher(dispatcher &&) = delete;
+
+        // Calls still queued are discarded.
+        ~dispatcher()
+        {
+            while (pop()) {}
+        }
+
+        // Returns false if the call was dropped.
+        template<typename Fn>
+        requires std::invocable<std::decay_t<Fn> &>
+        bool post(Fn && fn)
+        {
+            return push(task(std::forward<Fn>(fn)), true);
+        }
+
+        // As post(), but never waits for room: with the block policy, a call that doesn't fit
+        // goes to the overflow list, as it would with grow. Signals other than
+        // concurrent_signal post queued slot calls this way, since they hold their lock while
+        // they do, and the calls being dispatched may well need it.
+        template<typename Fn>
+        requires std::invocable<std::decay_t<Fn> &>
+        bool post_nowait(Fn && fn)
+        {
+            return push(task(std::forward<Fn>(fn)), false);
+        }
+
+        // Makes up to max queued calls, in the order they were posted (at least, for any one
+        // posting thread), and returns how many were made. If a call throws, the exception
+        // propagates, and the remaining calls stay queued.
+        std::size_t dispatch(std::size_t max = std::numeric_limits<std::size_t>::max())
+        {
+            auto previous = m_consumer.exchange(std::this_thread::get_id());
+            std::size_t n = 0;
+            try {
+                while (n != max) {
+                    std::optional<task> t;
+                    // Calls that overflowed were posted after everything left in the ring.
+                    if (m_spill_pos != m_spill.size()) {
+                        t.emplace(std::move(m_spill[m_spill_pos++]));
+                    } else {
+                        t = pop();
+                        if (!t) {
+                            if (!take_overflow()) break;
+                            continue;
+                        }
+                    }
+                    ++n;
+                    (*t)(false);
+                }
+            } catch (...) {
+                finish(previous, n);
+                throw;
+            }
+            finish(previous, n);
+            return n;
+        }
+
+        // Counters. These are all updated without any locking, so are only approximate while
+        // calls are being posted or dispatched.
+        [[nodiscard]] std::size_t depth() const
+        {
+            return m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed)
+                   + m_overflow_depth.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::size_t high_water() const
+        {
+            return m_high_water.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::size_t dropped() const
+        {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::size_t overflowed() const
+        {
+            return m_overflowed.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::size_t dispatched() const
+        {
+            return m_dispatched.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::size_t capacity() const
+        {
+            return m_mask + 1;
+        }
+
+    private:
+        // Each cell's sequence number says whose turn it is: equal to a producer's ticket when
+        // the cell is free for it, one more than the consumer's when there's a call to take.
+        struct cell {
+            std::atomic<std::size_t> sequence;
+            alignas(task) unsigned char storage[sizeof(task)];
+        };
+
+        bool push(task && t, bool wait)
+        {
+            // Once anything has overflowed, later calls follow it, so as to stay in order.
+            if (!m_overflowing.load(std::memory_order_acquire) && try_push(t)) return true;
+            switch (m_policy) {
+                case backpressure::drop:
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                case backpressure::block:
+                    // The dispatching thread can't wait for itself to make room.
+                    if (wait && m_consumer.load(std::memory_order_relaxed) != std::this_thread::get_id()) {
+                        while (m_overflowing.load(std::memory_order_acquire) || !try_push(t)) {
+                            std::this_thread::yield();
+                        }
+                        return true;
+                    }
+                    [[fallthrough]];
+                case backpressure::grow:
+                    break;
+            }
+            std::scoped_lock lock(m_overflow_mutex);
+            m_overflow.push_back(std::move(t));
+            m_overflowing.store(true, std::memory_order_release);
+            m_overflowed.fetch_add(1, std::memory_order_relaxed);
+            note_depth(m_overflow_depth.fetch_add(1, std::memory_order_relaxed) + 1
+                       + m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed));
+            return true;
+        }
+
+        bool try_push(task & t)
+        {
+            auto pos = m_tail.load(std::memory_order_relaxed);
+            for (;;) {
+                auto & c = m_cells[pos & m_mask];
+                auto seq = c.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if (diff == 0) {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        ::new (static_cast<void *>(c.storage)) task(std::move(t));
+                        c.sequence.store(pos + 1, std::memory_order_release);
+                        note_depth(pos + 1 - m_head.load(std::memory_order_relaxed));
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Only called by the dispatching thread.
+        std::optional<task> pop()
+        {
+            auto head = m_head.load(std::memory_order_relaxed);
+            auto & c = m_cells[head & m_mask];
+            auto seq = c.sequence.load(std::memory_order_acquire);
+            if (seq != head + 1) return std::nullopt;
+            auto * queued = std::launder(reinterpret_cast<task *>(c.storage));
+            std::optional<task> t{std::move(*queued)};
+            queued->~task();
+            c.sequence.store(head + m_mask + 1, std::memory_order_release);
+            m_head.store(head + 1, std::memory_order_relaxed);
+            return t;
+        }
+
+        bool take_overflow()
+        {
+            if (!m_overflowing.load(std::memory_order_acquire)) return false;
+            std::scoped_lock lock(m_overflow_mutex);
+            m_spill.clear();
+            m_spill_pos = 0;
+            std::swap(m_spill, m_overflow);
+            m_overflow_depth.fetch_sub(m_spill.size(), std::memory_order_relaxed);
+            m_overflowing.store(false, std::memory_order_release);
+            return !m_spill.empty();
+        }
+
+        void note_depth(std::size_t depth)
+        {
+            auto high = m_high_water.load(std::memory_order_relaxed);
+            while (depth > high && !m_high_water.compare_exchange_weak(high, depth, std::memory_order_relaxed)) {}
+        }
+
+        void finish(std::thread::id previous, std::size_t n)
+        {
+            m_dispatched.fetch_add(n, std::memory_order_relaxed);
+            m_consumer.store(previous);
+        }
+
+        const backpressure m_policy;
+        std::size_t m_mask;
+        std::unique_ptr<cell[]> m_cells;
+        alignas(64) std::atomic<std::size_t> m_tail{0};
+        alignas(64) std::atomic<std::size_t> m_head{0};
+        std::atomic<std::thread::id> m_consumer;
+        // Overflow, for the grow policy.
+        std::atomic<bool> m_overflowing{false};
+        std::mutex m_overflow_mutex;
+        std::vector<task> m_overflow;
+        std::vector<task> m_spill;
+        std::size_t m_spill_pos = 0;
+        // Counters.
+        std::atomic<std::size_t> m_overflow_depth{0};
+        std::atomic<std::size_t> m_high_water{0};
+        std::atomic<std::size_t> m_dropped{0};
+        std::atomic<std::size_t> m_overflowed{0};
+        std::atomic<std::size_t> m_dispatched{0};
+    };
+}
+
+#endif //SIGSLOT_DISPATCHER_H
@@ -0,0 +1,372 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#ifndef SIGSLOT_SIGNAL_MAP_H
+#define SIGSLOT_SIGNAL_MAP_H
+
+#include <sigslot/sigslot.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace sigslot {
+    // A set of signals looked up by key, for when each event is only of interest to the
+    // slots connected for its key - as in connect(domain, &sink, &Sink::connected), and
+    // later emit(domain, ...). Emitting only touches the slots for that key (and any
+    // wildcard slots), rather than calling every slot to have each check the key itself.
+    //
+    // Each key's slots are a signal of their own, created when the first slot is connected
+    // for the key, and removed again once the last is disconnected - whether explicitly, by
+    // its has_slots being destroyed, or by a one-shot slot firing. Connections behave just
+    // as they do with a plain signal, with the same choice of connect() arguments: one-shot,
+    // priority, executors, and handles.
+    //
+    // Keys are found through an open-addressing hash table, using std::hash<Key> and
+    // std::equal_to<Key>. The table, each key's signal, and its connections are all
+    // allocated from the memory resource the map was given, if any.
+    //
+    // The map's lock is held for the whole of each emission, slots included, so a slot may
+    // connect and disconnect on the emitting thread, but another thread doing so (or
+    // emitting) waits until the emission has finished. Slots connected to executors don't
+    // hold it up.
+    template<class mt_policy, class Key, class... args>
+    class basic_signal_map
+    {
+    public:
+        using has_slots_type = basic_has_slots<mt_policy>;
+        using connection_handle = basic_connection<mt_policy>;
+        using signal_type = basic_signal<mt_policy, args...>;
+        using wildcard_type = basic_signal<mt_policy, Key const &, args...>;
+
+        basic_signal_map() = default;
+
+        explicit basic_signal_map(std::pmr::memory_resource * resource) : m_buckets(resource), m_emptied(resource), m_sweeping(resource), m_any(resource) {}
+        basic_signal_map(basic_signal_map const &) = delete;
+        basic_signal_map(basic_signal_map &&) = delete;
+
+        ~basic_signal_map()
+        {
+            std::scoped_lock lock{m_barrier};
+            m_buckets.clear();
+        }
+
+        // Connects a slot for key; the remaining arguments are those for signal::connect().
+        template<typename... A>
+        decltype(auto) connect(Key const & key, A &&... a)
+        {
+            std::scoped_lock lock{m_barrier};
+            auto & e = find_or_create(key);
+            try {
+                return e.connect(std::forward<A>(a)...);
+            } catch (...) {
+                erase_if_idle(e);
+                throw;
+            }
+        }
+
+        template<auto memfn, typename... A>
+        decltype(auto) connect(Key const & key, A &&... a)
+        {
+            std::scoped_lock lock{m_barrier};
+            auto & e = find_or_create(key);
+            try {
+                return e.template connect<memfn>(std::forward<A>(a)...);
+            } catch (...) {
+                erase_if_idle(e);
+                throw;
+            }
+        }
+
+        // Connects a wildcard slot, called for every key, after that key's own slots. It
+        // gets the key as its first argument.
+        template<typename... A>
+        decltype(auto) connect_any(A &&... a)
+        {
+            return m_any.connect(std::forward<A>(a)...);
+        }
+
+        template<auto memfn, typename... A>
+        decltype(auto) connect_any(A &&... a)
+        {
+            return m_any.template connect<memfn>(std::forward<A>(a)...);
+        }
+
+        // Calls the slots for key, and then the wildcard slots. If there are no wildcard slots,
+        // the key's slots get the arguments just as they would from emitting a signal.
+        void emit(Key const & key, args... a)
+        {
+            std::scoped_lock lock{m_barrier};
+            sweep();
+            // Wildcard slots connected after this don't see this emission.
+            bool any = !m_any.idle();
+            auto hash = hash_of(key);
+            if (auto e = find(key, hash); e != npos) {
+                auto sig = m_buckets[e].signal.get();
+                if (any) sig->emit(a...); else sig->emit(std::forward<args>(a)...);
+                // The slots may have connected other keys, so look again.
+                if (sig->idle()) {
+                    if (auto again = find(key, hash); again != npos) erase(again);
+                }
+            }
+            if (any) m_any.emit(key, std::forward<args>(a)...);
+        }
+
+        void operator()(Key const & key, args... a)
+        {
+            this->emit(key, std::forward<args>(a)...);
+        }
+
+        // Disconnects every slot for key, but not the wildcard slots.
+        void disconnect(Key const & key)
+        {
+            std::scoped_lock lock{m_barrier};
+            if (auto e = find(key, hash_of(key)); e != npos) {
+                auto sig = m_buckets[e].signal.get();
+                sig->disconnect_all();
+                if (sig->idle()) erase(e);
+            }
+        }
+
+        void disconnect(has_slots_type * pclass)
+        {
+            std::scoped_lock lock{m_barrier};
+            for (auto & b : m_buckets) {
+                if (b.signal) b.signal->disconnect(pclass);
+            }
+            m_any.disconnect(pclass);
+            purge();
+        }
+
+        void disconnect_all()
+        {
+            std::scoped_lock lock{m_barrier};
+            for (auto & b : m_buckets) {
+                if (b.signal) b.signal->disconnect_all();
+            }
+            m_any.disconnect_all();
+            purge();
+        }
+
+        [[nodiscard]] bool contains(Key const & key)
+        {
+            std::scoped_lock lock{m_barrier};
+            sweep();
+            return find(key, hash_of(key)) != npos;
+        }
+
+        // The number of keys with slots connected.
+        [[nodiscard]] std::size_t size()
+        {
+            std::scoped_lock lock{m_barrier};
+            sweep();
+            return m_size;
+        }
+
+    private:
+        static constexpr std::size_t npos = ~std::size_t{0};
+
+        // A key's signal. It tells the map when it loses a slot other than by the map's own
+        // doing, so the map can check, next time it's used, whether that key can go.
+        class entry : public signal_type, private internal::_disconnect_listener {
+        public:
+            entry(basic_signal_map * map, Key const & k, std::pmr::memory_resource * resource)
+                    : signal_type(resource), key(k), m_map(map)
+            {
+                this->state_or_create()->m_disconnected = this;
+            }
+
+            // True if there are no slots left, and no emission is running.
+            bool idle()
+            {
+                auto state = this->state();
+                return !state || state->idle();
+            }
+
+            const Key key;
+            // Whether it's in the map's m_emptied; guarded by the map's m_emptied_barrier.
+            bool queued = false;
+
+        private:
+            // Called with this signal's lock held, and perhaps not the map's, so this can't
+            // touch the table; it just notes the entry for the map to check.
+            void disconnected() override
+            {
+                std::scoped_lock lock{m_map->m_emptied_barrier};
+                if (queued) return;
+                queued = true;
+                m_map->m_emptied.push_back(this);
+                m_map->m_sweep.store(true, std::memory_order_release);
+            }
+
+            basic_signal_map * m_map;
+        };
+
+        class wildcard : public wildcard_type {
+        public:
+            using wildcard_type::wildcard_type;
+
+            bool idle()
+            {
+                auto state = this->state();
+                return !state || state->idle();
+            }
+        };
+
+        struct entry_deleter {
+            void operator()(entry * e) const
+            {
+                std::pmr::polymorphic_allocator<>(e->resource()).delete_object(e);
+            }
+        };
+
+        struct bucket {
+            std::size_t hash = 0;
+            std::unique_ptr<entry, entry_deleter> signal;
+        };
+
+        // The remaining members must be called with m_barrier held.
+
+        // Fibonacci hashing mixes the bits of hashes that are far from random, such as
+        // aligned pointers, or std::hash of runs of integers.
+        static std::size_t hash_of(Key const & key)
+        {
+            return static_cast<std::size_t>(static_cast<std::uint64_t>(std::hash<Key>{}(key)) * 0x9E3779B97F4A7C15ull >> 32);
+        }
+
+        std::size_t home(std::size_t hash) const
+        {
+            return hash & (m_buckets.size() - 1);
+        }
+
+        std::size_t find(Key const & key, std::size_t hash) const
+        {
+            if (m_buckets.empty()) return npos;
+            for (auto i = home(hash);; i = (i + 1) & (m_buckets.size() - 1)) {
+                auto & b = m_buckets[i];
+                if (!b.signal) return npos;
+                if (b.hash == hash && std::equal_to<Key>{}(b.signal->key, key)) return i;
+            }
+        }
+
+        entry & find_or_create(Key const & key)
+        {
+            sweep();
+            auto hash = hash_of(key);
+            if (auto e = find(key, hash); e != npos) return *m_buckets[e].signal;
+            // Kept no more than three quarters full.
+            if ((m_size + 1) * 4 > m_buckets.size() * 3) rehash(std::max<std::size_t>(8, m_buckets.size() * 2));
+            auto & b = m_buckets[insertion_point(hash)];
+            b.hash = hash;
+            auto resource = m_buckets.get_allocator().resource();
+            b.signal.reset(std::pmr::polymorphic_allocator<>(resource).template new_object<entry>(this, key, resource));
+            ++m_size;
+            return *b.signal;
+        }
+
+        std::size_t insertion_point(std::size_t hash) const
+        {
+            auto i = home(hash);
+            while (m_buckets[i].signal) i = (i + 1) & (m_buckets.size() - 1);
+            return i;
+        }
+
+        void rehash(std::size_t capacity)
+        {
+            auto old = std::exchange(m_buckets, std::pmr::vector<bucket>(capacity, m_buckets.get_allocator()));
+            for (auto & b : old) {
+                if (b.signal) m_buckets[insertion_point(b.hash)] = std::move(b);
+            }
+        }
+
+        // Removes the entry at i, shifting back any that follow it in the same run, so that
+        // lookups never need to step over a hole.
+        void erase(std::size_t i)
+        {
+            auto mask = m_buckets.size() - 1;
+            unqueue(*m_buckets[i].signal);
+            m_buckets[i].signal.reset();
+            --m_size;
+            for (auto j = (i + 1) & mask; m_buckets[j].signal; j = (j + 1) & mask) {
+                auto h = home(m_buckets[j].hash);
+                // Leave it if its home lies cyclically within (i, j].
+                if (i <= j ? (i < h && h <= j) : (i < h || h <= j)) continue;
+                m_buckets[i] = std::move(m_buckets[j]);
+                i = j;
+            }
+        }
+
+        void erase_if_idle(entry & e)
+        {
+            if (!e.idle()) return;
+            if (auto i = find(e.key, hash_of(e.key)); i != npos) erase(i);
+        }
+
+        void unqueue(entry & e)
+        {
+            std::scoped_lock lock{m_emptied_barrier};
+            if (!e.queued) return;
+            e.queued = false;
+            std::erase(m_emptied, &e);
+        }
+
+        // Removes the keys noted as having lost a slot, if that was their last.
+        void sweep()
+        {
+            if (!m_sweep.exchange(false, std::memory_order_acquire)) return;
+            {
+                std::scoped_lock lock{m_emptied_barrier};
+                m_sweeping.swap(m_emptied);
+                for (auto e : m_sweeping) e->queued = false;
+            }
+            for (auto e : m_sweeping) erase_if_idle(*e);
+            m_sweeping.clear();
+        }
+
+        // Removes every key that has no slots left, for after disconnecting across the map.
+        void purge()
+        {
+            {
+                std::scoped_lock lock{m_emptied_barrier};
+                for (auto e : m_emptied) e->queued = false;
+                m_emptied.clear();
+                m_sweep.store(false, std::memory_order_relaxed);
+            }
+            bool removed = false;
+            for (auto & b : m_buckets) {
+                if (b.signal && b.signal->idle()) {
+                    // Another thread may have queued it since m_emptied was cleared.
+                    unqueue(*b.signal);
+                    b.signal.reset();
+                    --m_size;
+                    removed = true;
+                }
+            }
+            if (removed) rehash(m_buckets.size());
+        }
+
+        [[no_unique_address]] mt_policy m_barrier;
+        std::pmr::vector<bucket> m_buckets;
+        std::size_t m_size = 0;
+        // Entries that have lost a slot since the last sweep. Their own signal's lock may be
+        // held when they're added, so this has a lock of its own, always taken last.
+        [[no_unique_address]] mt_policy m_emptied_barrier;
+        std::pmr::vector<entry *> m_emptied;
+        std::pmr::vector<entry *> m_sweeping;
+        std::atomic<bool> m_sweep{false};
+        wildcard m_any;
+    };
+
+    template<class Key, class... args>
+    using signal_map = basic_signal_map<SIGSLOT_DEFAULT_MT_POLICY, Key, args...>;
+
+    namespace st {
+        template<class Key, class... args>
+        using signal_map = basic_signal_map<single_threaded, Key, args...>;
+    }
+}
+
+#endif //SIGSLOT_SIGNAL_MAP_H
@@ -15,6 +15,36 @@
 //          If not defined, this will provide an operator co_await(), so that coroutines can
 //          co_await on a signal instead of registering a callback.
 //
+//          SIGSLOT_INPLACE_CAPACITY:
+//          Bytes of storage each connection has for the slot's function object (default is
+//          four pointers' worth). Larger function objects are allocated on the heap.
+//
+//          SIGSLOT_NO_HEAP_SLOTS:
+//          If defined, connecting a function object too large for SIGSLOT_INPLACE_CAPACITY
+//          is a compile-time error instead of a heap allocation.
+//
+//          SIGSLOT_NO_INSTRUMENTATION:
+//          If defined, signals can't be instrumented (see sigslot/stats.h), and emission
+//          doesn't check whether they are.
+//
+//          SIGSLOT_NO_TRACING:
+//          If defined, emissions and coroutine resumptions can't be traced (see
+//          sigslot/trace.h), and don't check whether they are.
+//
+//          SIGSLOT_DEFAULT_MT_POLICY:
+//          The threading policy used by plain sigslot::signal and sigslot::has_slots.
+//          Defaults to multi_threaded_local.
+//
+//      MEMORY
+//
+//      A signal can be given a std::pmr::memory_resource when it's constructed, which it then
+//      uses for everything a connection needs: the connection itself, the signal's slot
+//      storage, any function object too large to store in place, and the state shared with
+//      calls posted to an executor. Awaiting a signal connects to it, so allocates the same
+//      way. Otherwise, the default resource is used. The resource must outlive the signal
+//      and any handles on its connections, and handles on other threads may release what
+//      they hold back to it, so it needs to be thread-safe if they're used that way.
+//
 //      PLATFORM NOTES
 //
 //      The header file requires C++11 (certainly), C++14 (probably), and C++17 (maybe).
@@ -22,7 +52,21 @@
 //
 //      THREADING MODES
 //
-//       Only C++11 threading remains.
+//       Only C++11 threading remains, but it can be compiled out.
+//
+//       multi_threaded_local:
+//       Each signal and has_slots has its own recursive mutex. This is the default, and
+//       is what sigslot::signal<...> and sigslot::has_slots use.
+//
+//       Either way, a signal is a single pointer, and a has_slots two, until something is
+//       connected; only then is the state, lock included, allocated.
+//
+//       single_threaded:
+//       No locking at all. Use basic_signal<single_threaded, ...> and
+//       basic_has_slots<single_threaded>, or their sigslot::st::signal<...> and
+//       sigslot::st::has_slots aliases, for objects that never leave their thread.
+//
+//       A signal can only connect to a has_slots with the same policy.
 //
 //      USING THE LIBRARY
 //
@@ -33,10 +77,25 @@
 #ifndef SIGSLOT_H__
 #define SIGSLOT_H__
 
-#include <set>
-#include <list>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #ifndef SIGSLOT_NO_COROUTINES
 #include <optional>
 #include <coroutine>
@@ -44,6 +103,50 @@
 #endif
 
 #include <sigslot/resume.h>
+#ifndef SIGSLOT_NO_INSTRUMENTATION
+#include <sigslot/stats.h>
+#else
+#include <chrono>
+
+namespace sigslot::internal {
+    // With instrumentation compiled out, no signal has statistics, so none of these are called.
+    struct _slot_stats {};
+
+    struct _signal_stats {
+        using clock = std::chrono::steady_clock;
+        _slot_stats * add_slot(void const *) { return nullptr; }
+        static void remove_slot(_slot_stats *) {}
+        void sweep() {}
+        void emitted(std::uint64_t = 1) {}
+        void expired() {}
+        void waited(clock::duration) {}
+        void called(_slot_stats *, clock::duration) {}
+        std::string name() const { return {}; }
+    };
+}
+#endif
+#ifndef SIGSLOT_NO_TRACING
+#include <sigslot/trace.h>
+#else
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace sigslot::internal {
+    enum class _trace_category : char { signal, slot, tasklet };
+
+    // With tracing compiled out, nothing is ever traced.
+    struct _trace {
+        using clock = std::chrono::steady_clock;
+        static constexpr bool on() { return false; }
+        static void complete(_trace_category, std::string_view, void const *, clock::time_point, clock::time_point = {}) {}
+        static void instant(_trace_category, std::string_view, void const *) {}
+        static void name(void const *, std::string const &) {}
+        static void forget(void const *) {}
+        static std::string name_of(void const *) { return {}; }
+    };
+}
+#endif
 
 namespace sigslot {
 #ifndef SIGSLOT_NO_COROUTINES
@@ -57,6 +160,20 @@ namespace sigslot {
     }
     inline void resume_switch(std::coroutine_handle<>  coro) {
         using return_type = decltype(resume(coro));
+        if (internal::_trace::on()) [[unlikely]] {
+            // The coroutine may be gone once resumed, so it's named first.
+            auto name = internal::_trace::name_of(coro.address());
+            if constexpr (std::is_same_v<return_type, coroutines::sentinel>) {
+                auto start = internal::_trace::clock::now();
+                resume_dispatch<return_type>(coro);
+                internal::_trace::complete(internal::_trace_category::tasklet, name, coro.address(), start);
+            } else {
+                // Resumption is left to the event loop, so all that can be traced is the request.
+                internal::_trace::instant(internal::_trace_category::tasklet, name, coro.address());
+                resume_dispatch<return_type>(coro);
+            }
+            return;
+        }
         resume_dispatch<return_type>(coro);
     }
     template<typename R>
@@ -81,383 +198,1896 @@ namespace sigslot {
     }
 #endif
 
-    class has_slots;
+    // Threading policies, which are simply the lock each signal and has_slots holds.
+    class single_threaded
+    {
+    public:
+        void lock() {}
+        void unlock() {}
+        bool try_lock() { return true; }
+    };
+
+    class multi_threaded_local : public std::recursive_mutex {};
+
+#ifndef SIGSLOT_DEFAULT_MT_POLICY
+#define SIGSLOT_DEFAULT_MT_POLICY multi_threaded_local
+#endif
+
+    template<class mt_policy> class basic_has_slots;
 
     namespace internal {
+        template<class mt_policy> class _signal_base_lo;
+
+        // One of these exists for every connection, at a fixed address, so it can sit in its
+        // has_slots' intrusive list of connections. The signal keeps track of it alongside
+        // its slot, and the link (or rather, the signal's extension of it) knows where that
+        // slot is kept, so either side can break the connection without searching.
+        //
+        // It's reference counted, the signal holding one reference and each connection
+        // handle another, so handles can outlive the connection itself. Once the signal has
+        // broken the connection, signal is null.
+        template<class mt_policy>
+        struct _connection_link {
+            _signal_base_lo<mt_policy> * signal;
+            basic_has_slots<mt_policy> * dest;
+            _connection_link * prev = nullptr;
+            _connection_link * next = nullptr;
+            bool blocked = false;
+            [[no_unique_address]] mutable mt_policy m_barrier;
+
+            _connection_link(_signal_base_lo<mt_policy> * s, basic_has_slots<mt_policy> * d)
+                    : signal(s), dest(d) {}
+            _connection_link(_connection_link const &) = delete;
+            virtual ~_connection_link() = default;
+
+            void ref()
+            {
+                m_refs.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void unref()
+            {
+                if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) destroy();
+            }
+
+            // Called by the signal, with its lock held, as it breaks the connection.
+            void detach();
+
+            // Called by the has_slots once it has broken the connection and released its lock,
+            // to wait for anything still calling the slot. Most signals have nothing to wait for.
+            virtual void quiesce() {}
+
+        protected:
+            // Frees the link, once the last reference has gone.
+            virtual void destroy()
+            {
+                delete this;
+            }
+
+        private:
+            std::atomic<std::size_t> m_refs{1};
+        };
+
+        enum class _slot_op { disconnect, block, unblock };
+
+        template<class mt_policy>
         class _signal_base_lo {
         protected:
-            std::recursive_mutex m_barrier;
+            [[no_unique_address]] mt_policy m_barrier;
         public:
-            virtual void slot_disconnect(has_slots *pslot) = 0;
+            // Called by a has_slots, with its own lock held, to break a single connection.
+            // Locks are always taken signal first, then has_slots, so this only try-locks
+            // the signal, and returns false if it would have to wait; the has_slots then
+            // releases its lock and tries again. On success, the link has been released.
+            virtual bool slot_disconnect(_connection_link<mt_policy> * link) = 0;
+            // Likewise, but called by a connection handle with the link's lock held.
+            virtual bool slot_update(_connection_link<mt_policy> * link, _slot_op op) = 0;
             virtual ~_signal_base_lo() = default;
         };
-    }
 
+        // Shared between a has_slots and any calls to it posted to executors, so the calls
+        // can tell if it's gone, and its destructor can wait for those already running.
+        class _liveness {
+        public:
+            // Held by each thread making a call, so the destructor can tell if it's destroying
+            // the has_slots from within one of its own calls, and can't wait for it.
+            class guard {
+            public:
+                explicit guard(_liveness * l) : m_liveness(l), m_prev(s_current)
+                {
+                    s_current = this;
+                }
+                guard(guard const &) = delete;
 
-    class has_slots
-    {
-    private:
-        std::recursive_mutex m_barrier;
-
-    public:
-        has_slots() = default;
+                ~guard()
+                {
+                    s_current = m_prev;
+                }
 
-        has_slots(const has_slots& hs) = delete;
-        has_slots(has_slots && hs) = delete;
+                static bool held(_liveness * l)
+                {
+                    for (auto g = s_current; g; g = g->m_prev) {
+                        if (g->m_liveness == l) return true;
+                    }
+                    return false;
+                }
 
-        void signal_connect(internal::_signal_base_lo* sender)
-        {
-            std::scoped_lock lock(m_barrier);
-            m_senders.insert(sender);
-        }
+            private:
+                _liveness * m_liveness;
+                guard * m_prev;
+                static inline thread_local guard * s_current = nullptr;
+            };
 
-        void signal_disconnect(internal::_signal_base_lo* sender)
-        {
-            std::scoped_lock lock(m_barrier);
-            m_senders.erase(sender);
-        }
+            std::atomic<bool> alive = true;
+            std::shared_mutex running;
 
-        virtual ~has_slots()
-        {
-            disconnect_all();
-        }
+            void retire()
+            {
+                alive.store(false);
+                if (!guard::held(this)) std::unique_lock wait(running);
+            }
+        };
 
-        void disconnect_all()
+        // A pointer to an object's state, which isn't created until it's first needed, so
+        // an object that's never used costs just this one word. Until then, it can hold the
+        // memory resource to create the state from, tagged by its low bit. The state is
+        // made by T::create(resource); if two threads race to create it, the loser's is
+        // given to T::destroy(). The owner destroys the state itself, if there is one.
+        template<class mt_policy, class T>
+        class _lazy_state
         {
-            std::scoped_lock lock(m_barrier);
-            for (auto i : m_senders) {
-                i->slot_disconnect(this);
-            }
+        public:
+            _lazy_state() = default;
 
-            m_senders.erase(m_senders.begin(), m_senders.end());
-        }
+            explicit _lazy_state(std::pmr::memory_resource * resource)
+                    : m_word(reinterpret_cast<std::uintptr_t>(resource) | 1) {}
 
-    private:
-        std::set<internal::_signal_base_lo *>  m_senders;
-    };
+            _lazy_state(_lazy_state const &) = delete;
 
-    namespace internal {
-        template<class... args>
-        class _connection
-        {
-        public:
-            _connection(has_slots *pobject, std::function<void(args... a)> fn, bool once)
-                    : one_shot(once), m_pobject(pobject), m_fn(fn) {}
+            [[nodiscard]] T * get() const
+            {
+                auto w = load();
+                return (w & 1) ? nullptr : reinterpret_cast<T *>(w);
+            }
 
-            void emit(args... a)
+            [[nodiscard]] std::pmr::memory_resource * resource() const
             {
-                m_fn(a...);
+                return resource(load());
             }
 
-            [[nodiscard]] has_slots* getdest() const
+            T * get_or_create()
             {
-                return m_pobject;
+                auto w = load();
+                if (w && !(w & 1)) return reinterpret_cast<T *>(w);
+                auto state = T::create(resource(w));
+                auto created = reinterpret_cast<std::uintptr_t>(state);
+                if constexpr (std::is_same_v<mt_policy, single_threaded>) {
+                    m_word = created;
+                } else if (!m_word.compare_exchange_strong(w, created, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    T::destroy(state);
+                    return reinterpret_cast<T *>(w);
+                }
+                return state;
             }
 
-            const bool one_shot = false;
-            bool expired = false;
         private:
-            has_slots* m_pobject;
-            std::function<void(args...)> m_fn;
-        };
-
-        template<class... args>
-        class _signal_base : public _signal_base_lo
-        {
-        public:
-            _signal_base() = default;
-
-            _signal_base(const _signal_base& s)
-                    : _signal_base_lo(s), m_connected_slots()
+            std::uintptr_t load() const
             {
-                std::scoped_lock lock(m_barrier);
-                for (auto i : s.m_connected_slots) {
-                    i->getdest()->signal_connect(this);
-                    m_connected_slots.push_back(i->clone());
+                if constexpr (std::is_same_v<mt_policy, single_threaded>) {
+                    return m_word;
+                } else {
+                    return m_word.load(std::memory_order_acquire);
                 }
             }
 
-            _signal_base(_signal_base &&) = delete;
+            static std::pmr::memory_resource * resource(std::uintptr_t w)
+            {
+                if (w & 1) return reinterpret_cast<std::pmr::memory_resource *>(w & ~std::uintptr_t{1});
+                if (w) return reinterpret_cast<T *>(w)->resource();
+                return std::pmr::get_default_resource();
+            }
+
+            std::conditional_t<std::is_same_v<mt_policy, single_threaded>, std::uintptr_t, std::atomic<std::uintptr_t>> m_word{0};
+        };
+    }
+
+
+    // Holds nothing but a pointer to its state, which is created when its first slot is
+    // connected, from the default memory resource.
+    template<class mt_policy>
+    class basic_has_slots
+    {
+    private:
+        using link_type = internal::_connection_link<mt_policy>;
+
+        struct state {
+            [[no_unique_address]] mt_policy m_barrier;
+            link_type * m_head = nullptr;
+            std::shared_ptr<internal::_liveness> m_liveness;
+            std::pmr::memory_resource * const m_resource;
+
+            explicit state(std::pmr::memory_resource * resource) : m_resource(resource) {}
 
-            virtual ~_signal_base()
+            [[nodiscard]] std::pmr::memory_resource * resource() const
             {
-                disconnect_all();
+                return m_resource;
             }
 
-            void disconnect_all()
+            static state * create(std::pmr::memory_resource * resource)
             {
-                std::scoped_lock lock(m_barrier);
-                for (auto i : m_connected_slots) {
-                    i->getdest()->signal_disconnect(this);
-                    delete i;
-                }
-                m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+                return std::pmr::polymorphic_allocator<>(resource).template new_object<state>(resource);
             }
 
-            void disconnect(has_slots* pclass)
+            static void destroy(state * s)
             {
-                std::scoped_lock lock(m_barrier);
-                bool found{false};
-                m_connected_slots.remove_if([pclass, &found](_connection<args...> * x) {
-                    if (x->getdest() == pclass) {
-                        delete x;
-                        found = true;
-                        return true;
-                    }
-                    return false;
-                });
-                if (found) pclass->signal_disconnect(this);
+                std::pmr::polymorphic_allocator<>(s->resource()).delete_object(s);
+            }
+        };
+
+    public:
+        basic_has_slots() = default;
+
+        basic_has_slots(const basic_has_slots& hs) = delete;
+        basic_has_slots(basic_has_slots && hs) = delete;
+
+        // Signals call these, with their own lock held, as each connection is made or broken.
+        void signal_connect(link_type * link)
+        {
+            auto s = m_state.get_or_create();
+            std::scoped_lock lock(s->m_barrier);
+            link->prev = nullptr;
+            link->next = s->m_head;
+            if (s->m_head) s->m_head->prev = link;
+            s->m_head = link;
+        }
+
+        void signal_disconnect(link_type * link)
+        {
+            auto s = m_state.get();
+            std::scoped_lock lock(s->m_barrier);
+            if (link->prev) link->prev->next = link->next; else s->m_head = link->next;
+            if (link->next) link->next->prev = link->prev;
+        }
+
+        // Breaks every connection from sender; called by sender, with its lock held.
+        void signal_disconnect_all(internal::_signal_base_lo<mt_policy> * sender)
+        {
+            auto s = m_state.get();
+            if (!s) return;
+            std::scoped_lock lock(s->m_barrier);
+            for (auto link = s->m_head; link;) {
+                auto next = link->next;
+                if (link->signal == sender) sender->slot_disconnect(link);
+                link = next;
             }
+        }
 
-            void slot_disconnect(has_slots* pslot) final
+        virtual ~basic_has_slots()
+        {
+            auto s = m_state.get();
+            if (!s) return;
+            std::shared_ptr<internal::_liveness> liveness;
             {
-                std::scoped_lock lock(m_barrier);
-                m_connected_slots.remove_if(
-                    [pslot](_connection<args...> * x) {
-                        if (x->getdest() == pslot) {
-                            delete x;
-                            return true;
-                        }
-                        return false;
-                    }
-                );
+                std::scoped_lock lock(s->m_barrier);
+                liveness = s->m_liveness;
             }
+            if (liveness) liveness->retire();
+            disconnect_all();
+            state::destroy(s);
+        }
 
-        protected:
-            std::list<_connection<args...> *>  m_connected_slots;
-        };
+        void disconnect_all()
+        {
+            auto s = m_state.get();
+            if (!s) return;
+            for (;;) {
+                std::unique_lock lock(s->m_barrier);
+                auto link = s->m_head;
+                if (!link) return;
+                link->ref();
+                bool done = link->signal->slot_disconnect(link);
+                lock.unlock();
+                if (done) link->quiesce(); else std::this_thread::yield();
+                link->unref();
+            }
+        }
 
-    }
+        // Created on first use, by connecting one of this object's slots to an executor.
+        std::shared_ptr<internal::_liveness> liveness()
+        {
+            auto s = m_state.get_or_create();
+            std::scoped_lock lock(s->m_barrier);
+            if (!s->m_liveness) s->m_liveness = std::make_shared<internal::_liveness>();
+            return s->m_liveness;
+        }
 
+    private:
+        internal::_lazy_state<mt_policy, state> m_state;
+    };
 
-#ifndef SIGSLOT_NO_COROUTINES
-    namespace coroutines {
-        template<class... args> struct awaitable;
-    }
-#endif
+    using has_slots = basic_has_slots<SIGSLOT_DEFAULT_MT_POLICY>;
 
+    template<class mt_policy>
+    void internal::_connection_link<mt_policy>::detach()
+    {
+        if (dest) dest->signal_disconnect(this);
+        std::scoped_lock lock(m_barrier);
+        signal = nullptr;
+    }
 
-    template<class... args>
-    class signal : public internal::_signal_base<args...>
+    // A handle on a single connection, as returned by connect(). Handles are cheap to copy,
+    // and can disconnect, block or unblock their connection without searching for it. They
+    // stay valid after the connection has gone, whether by disconnection, by its signal or
+    // has_slots being destroyed, or by a one-shot slot being called; they just no longer
+    // do anything.
+    template<class mt_policy>
+    class basic_connection
     {
     public:
-        signal() = default;
+        basic_connection() = default;
+
+        explicit basic_connection(internal::_connection_link<mt_policy> * link) : m_link(link)
+        {
+            if (m_link) m_link->ref();
+        }
+
+        basic_connection(basic_connection const & other) : basic_connection(other.m_link) {}
 
-        signal(const signal<args...>& s) = default;
+        basic_connection(basic_connection && other) noexcept : m_link(std::exchange(other.m_link, nullptr)) {}
 
-        void connect(has_slots *pclass, std::function<void(args...)> &&fn, bool one_shot = false)
+        basic_connection & operator=(basic_connection other) noexcept
         {
-            std::scoped_lock lock{internal::_signal_base<args...>::m_barrier};
-            auto *conn = new internal::_connection<args...>(
-                    pclass, std::move(fn), one_shot);
-            this->m_connected_slots.push_back(conn);
-            pclass->signal_connect(this);
+            std::swap(m_link, other.m_link);
+            return *this;
         }
-        
-        // Helper for ptr-to-member; call the member function "normally".
-        template<class desttype>
-        requires std::derived_from<desttype, has_slots>
-        void connect(desttype *pclass, void (desttype::* memfn)(args...), bool one_shot = false)
+
+        ~basic_connection()
         {
-            this->connect(pclass, [pclass, memfn](args... a) { (pclass->*memfn)(a...); }, one_shot);
+            if (m_link) m_link->unref();
         }
 
-        [[nodiscard]] std::unique_ptr<has_slots> connect(std::function<void(args...)> && fn, bool one_shot=false)
+        [[nodiscard]] bool connected() const
         {
-            auto raii = std::make_unique<has_slots>();
-            this->connect(raii.get(), std::move(fn), one_shot);
-            return raii;
+            if (!m_link) return false;
+            std::scoped_lock lock(m_link->m_barrier);
+            return m_link->signal;
         }
 
-        // This code uses the long-hand because it assumes it may mutate the list.
-        void emit(args... a)
+        [[nodiscard]] bool blocked() const
         {
-            std::scoped_lock lock{internal::_signal_base<args...>::m_barrier};
-            auto it = this->m_connected_slots.begin();
-            auto itNext = it;
-            auto itEnd = this->m_connected_slots.end();
+            if (!m_link) return false;
+            std::scoped_lock lock(m_link->m_barrier);
+            return m_link->blocked;
+        }
 
-            while(it != itEnd)
-            {
-                itNext = it;
-                ++itNext;
+        void disconnect()
+        {
+            update(internal::_slot_op::disconnect);
+        }
 
-                if ((*it)->one_shot) {
-                    (*it)->expired = true;
-                }
-                (*it)->emit(a...);
+        // As disconnect(), but gives up rather than wait for a signal locked by another
+        // thread. Returns false if it gave up.
+        bool try_disconnect()
+        {
+            return update(internal::_slot_op::disconnect, false);
+        }
 
-                it = itNext;
-            }
+        // A blocked slot is skipped by emission until unblocked.
+        void block()
+        {
+            update(internal::_slot_op::block);
+        }
 
-            this->m_connected_slots.remove_if([this](internal::_connection<args...> *x) {
-                if (x->expired) {
-                    x->getdest()->signal_disconnect(this);
-                    delete x;
+        void unblock()
+        {
+            update(internal::_slot_op::unblock);
+        }
+
+    private:
+        // Locks are taken signal first, then link, so this backs off just as has_slots does.
+        bool update(internal::_slot_op op, bool wait = true)
+        {
+            if (!m_link) return true;
+            for (;;) {
+                std::unique_lock lock(m_link->m_barrier);
+                if (!m_link->signal) return true;
+                if (m_link->signal->slot_update(m_link, op)) {
+                    if (op != internal::_slot_op::disconnect) m_link->blocked = (op == internal::_slot_op::block);
                     return true;
                 }
-                return false;
-            });
-            // Might need to reconnect new signals. This needs improvement...
-            for (auto const conn : this->m_connected_slots) {
-                conn->getdest()->signal_connect(this);
+                if (!wait) return false;
+                lock.unlock();
+                std::this_thread::yield();
             }
         }
 
-        void operator()(args... a)
+        internal::_connection_link<mt_policy> * m_link = nullptr;
+    };
+
+    // A connection handle that disconnects when it goes out of scope. Move-only.
+    template<class mt_policy>
+    class basic_scoped_connection : public basic_connection<mt_policy>
+    {
+    public:
+        basic_scoped_connection() = default;
+        basic_scoped_connection(basic_connection<mt_policy> && conn) noexcept : basic_connection<mt_policy>(std::move(conn)) {}
+        basic_scoped_connection(basic_scoped_connection &&) noexcept = default;
+        basic_scoped_connection & operator=(basic_scoped_connection && other) noexcept
         {
-            this->emit(a...);
+            if (this != &other) {
+                this->disconnect();
+                basic_connection<mt_policy>::operator=(std::move(other));
+            }
+            return *this;
         }
 
-#ifndef SIGSLOT_NO_COROUTINES
-        auto operator co_await() const {
-            return coroutines::awaitable<args...>(const_cast<signal &>(*this));
+        ~basic_scoped_connection()
+        {
+            this->disconnect();
         }
-#endif
-    };
 
+        // Gives up the scope, leaving the connection in place.
+        basic_connection<mt_policy> release()
+        {
+            return std::move(*this);
+        }
+    };
 
-#ifndef SIGSLOT_NO_COROUTINES
-    namespace coroutines {
-        // Generic variant uses a tuple to pass back.
-        template<typename... Args>
-        struct awaitable : public has_slots {
-            ::sigslot::signal<Args...> & signal;
-            std::coroutine_handle<> awaiting = nullptr;
-            std::optional<std::tuple<Args...>> payload;
+    using connection = basic_connection<SIGSLOT_DEFAULT_MT_POLICY>;
+    using scoped_connection = basic_scoped_connection<SIGSLOT_DEFAULT_MT_POLICY>;
 
-            explicit awaitable(::sigslot::signal<Args...> & s) : signal(s) {
-                signal.connect(this, &awaitable::resolve);
-            }
-            awaitable(awaitable const & a) : signal(a.signal), payload(a.payload) {
-                signal.connect(this, &awaitable::resolve);
-            }
-            awaitable(awaitable && other) noexcept : signal(other.signal), payload(std::move(other.payload)) {
-                signal.connect(this, &awaitable::resolve);
-            }
+    namespace internal {
+        // Stands in for a slot call in the executor concept.
+        struct _task_probe {
+            void operator()() {}
+        };
+    }
 
-            bool await_ready() {
-                return payload.has_value();
-            }
+    // Anything with a post() that takes a function object and arranges for it to be called,
+    // whether on a particular thread, like sigslot::dispatcher, or by a thread pool. If post()
+    // returns a bool, false means the call was dropped. If there's also a post_nowait(), which
+    // mustn't wait for the executor to make room, signals that hold their lock while emitting
+    // use that instead.
+    template<class E>
+    concept executor = requires(E & e, internal::_task_probe f) {
+        e.post(std::move(f));
+    };
 
-            void await_suspend(std::coroutine_handle<> h) {
-                // The awaiting coroutine is already suspended.
-                awaiting = h;
+    namespace internal {
+        // A slot whose calls are posted to an executor, rather than made during emission. It's
+        // shared between the connection and every call still waiting. Each call checks its
+        // has_slots is still alive, and its connection is still there, before calling, and
+        // holds off the has_slots' destruction while it runs. Executor is a reference if the
+        // executor was passed as an lvalue, and a copy otherwise.
+        //
+        // A one-shot call disconnects without waiting for the signal's lock, since an emission
+        // holding it may be waiting on the executor. If that fails, the next emission does it.
+        template<class mt_policy, class F, class Executor>
+        struct _queued_slot {
+            F fn;
+            Executor executor;
+            std::shared_ptr<_liveness> liveness;
+            basic_connection<mt_policy> conn;
+            const bool one_shot;
+            std::atomic<bool> fired = false;
+            std::atomic<bool> spent = false;
+
+            template<typename Fn, typename Ex>
+            _queued_slot(Fn && f, Ex && ex, std::shared_ptr<_liveness> && l, bool once)
+                    : fn(std::forward<Fn>(f)), executor(std::forward<Ex>(ex)), liveness(std::move(l)), one_shot(once) {}
+
+            // What's connected to the signal in place of the slot itself. If the signal's
+            // emission holds its lock, posting won't wait for the executor, if it can help it.
+            template<bool locked, class... args>
+            static auto trampoline(std::shared_ptr<_queued_slot> self)
+            {
+                return [self = std::move(self)](auto &&... a) {
+                    if (self->one_shot && self->fired.exchange(true)) {
+                        if (self->spent.load()) self->conn.try_disconnect();
+                        return;
+                    }
+                    if (!self->template post<locked>([self, payload = std::tuple<std::decay_t<args>...>(std::forward<decltype(a)>(a)...)]() mutable {
+                        self->template call<args...>(payload);
+                    })) {
+                        self->fired = false;
+                    }
+                };
             }
 
-            auto await_resume() {
-                return *payload;
+        private:
+            template<bool locked, class Task>
+            bool post(Task && task)
+            {
+                auto submit = [this](Task && t) -> decltype(auto) {
+                    if constexpr (locked && requires { executor.post_nowait(std::forward<Task>(t)); }) {
+                        return executor.post_nowait(std::forward<Task>(t));
+                    } else {
+                        return executor.post(std::forward<Task>(t));
+                    }
+                };
+                if constexpr (std::same_as<decltype(submit(std::forward<Task>(task))), bool>) {
+                    return submit(std::forward<Task>(task));
+                } else {
+                    submit(std::forward<Task>(task));
+                    return true;
+                }
             }
 
-            void resolve(Args... a) {
-                payload.emplace(a...);
-                if (awaiting) ::sigslot::resume_switch(awaiting);
+            template<class... args, class Payload>
+            void call(Payload & payload)
+            {
+                std::shared_lock<std::shared_mutex> running;
+                if (liveness) {
+                    running = std::shared_lock(liveness->running);
+                    if (!liveness->alive.load()) return;
+                }
+                if (!conn.connected()) return;
+                if (one_shot) {
+                    spent = true;
+                    conn.try_disconnect();
+                }
+                _liveness::guard guard(liveness.get());
+                [&]<std::size_t... I>(std::index_sequence<I...>) {
+                    fn(static_cast<args &&>(std::get<I>(payload))...);
+                }(std::index_sequence_for<args...>{});
             }
         };
+    }
 
-        // Single argument version uses a bare T
-        template<typename T>
-        struct awaitable<T> : public has_slots {
-            ::sigslot::signal<T> & signal;
-            std::coroutine_handle<> awaiting = nullptr;
-            std::optional<T> payload;
-            explicit awaitable(::sigslot::signal<T> & s) : signal(s) {
-                signal.connect(this, &awaitable::resolve);
-            }
-            awaitable(awaitable const & a) : signal(a.signal), payload(a.payload) {
-                signal.connect(this, &awaitable::resolve);
-            }
-            awaitable(awaitable && other) noexcept : signal(other.signal), payload(std::move(other.payload)) {
-                signal.connect(this, &awaitable::resolve);
-            }
+    // The priority of a connection. Slots with a higher priority are called first, and
+    // those with equal priority (by default, zero) in the order they were connected. For
+    // slots connected to an executor, this is the order their calls are posted in.
+    struct priority {
+        int value = 0;
+    };
 
-            bool await_ready() {
-                return payload.has_value();
-            }
+#ifndef SIGSLOT_INPLACE_CAPACITY
+#define SIGSLOT_INPLACE_CAPACITY (4 * sizeof(void *))
+#endif
 
-            void await_suspend(std::coroutine_handle<> h) {
-                // The awaiting coroutine is already suspended.
-                awaiting = h;
+    namespace internal {
+        // How emission passes each argument along to the slots: by reference, except for
+        // small trivially copyable types, which are cheaper to pass in registers.
+        template<class T>
+        using _slot_arg = std::conditional_t<
+                !std::is_reference_v<T> && std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void *),
+                T, T &>;
+
+        // True if any argument could usefully be moved into the last slot.
+        template<class... args>
+        constexpr bool _can_consume = (... || (!std::is_reference_v<args> && !std::is_trivially_copyable_v<args>));
+
+        // A type-erased function object, much like std::function, but stored in place.
+        // Anything up to capacity bytes lives inside the object itself; only
+        // larger function objects are put on the heap. It can hold move-only function objects;
+        // copying one of those throws std::logic_error. Trivially copyable function objects
+        // (such as bound member delegates) are moved and copied by memcpy, with no manager.
+        // Calls return R, which may well be void.
+        template<std::size_t capacity, class R, class... args>
+        class _basic_inplace_function
+        {
+        public:
+            template<typename F>
+            static constexpr bool fits_inplace = sizeof(F) <= capacity
+                                                 && alignof(F) <= alignof(std::max_align_t)
+                                                 && std::is_nothrow_move_constructible_v<F>;
+
+            template<typename F>
+            static constexpr bool is_trivial = fits_inplace<F> && std::is_trivially_copyable_v<F>;
+
+            // Function objects too large to store in place are allocated from resource.
+            template<typename Fn>
+            requires (!std::same_as<std::decay_t<Fn>, _basic_inplace_function>) && std::is_invocable_r_v<R, std::decay_t<Fn> &, args...>
+            explicit _basic_inplace_function(Fn && fn, std::pmr::memory_resource * resource = std::pmr::get_default_resource())
+            {
+                using F = std::decay_t<Fn>;
+                if constexpr (fits_inplace<F>) {
+                    ::new (static_cast<void *>(m_storage)) F(std::forward<Fn>(fn));
+                    m_invoke = [](void * storage, bool consume, _slot_arg<args>... a) -> R {
+                        return invoke(*std::launder(reinterpret_cast<F *>(storage)), consume, a...);
+                    };
+                    if constexpr (!is_trivial<F>) m_manage = &manage_inplace<F>;
+                } else {
+#ifdef SIGSLOT_NO_HEAP_SLOTS
+                    static_assert(fits_inplace<F>, "Function object is too large to be stored in place");
+#else
+                    static_assert(sizeof(heap_ref<F>) <= capacity, "Capacity is too small to refer to a function object on the heap");
+                    std::pmr::polymorphic_allocator<> alloc(resource);
+                    ::new (static_cast<void *>(m_storage)) heap_ref<F>{alloc.template new_object<F>(std::forward<Fn>(fn)), resource};
+                    m_invoke = [](void * storage, bool consume, _slot_arg<args>... a) -> R {
+                        return invoke(*std::launder(reinterpret_cast<heap_ref<F> *>(storage))->f, consume, a...);
+                    };
+                    m_manage = &manage_heap<F>;
+#endif
+                }
             }
 
-            auto await_resume() {
-                return *payload;
+            _basic_inplace_function(_basic_inplace_function && other) noexcept
+                    : m_invoke(other.m_invoke), m_manage(other.m_manage)
+            {
+                transfer(op::move, other.m_storage);
             }
 
-            void resolve(T a) {
-                payload.emplace(a);
-                if (awaiting) ::sigslot::resume_switch(awaiting);
-            }
-        };
+            _basic_inplace_function(_basic_inplace_function const & other)
+                    : _basic_inplace_function(other, nullptr) {}
 
-        // Single argument reference version uses a bare T &
-        template<typename T>
-        struct awaitable<T&> : public has_slots {
-            ::sigslot::signal<T&> & signal;
-            std::coroutine_handle<> awaiting = nullptr;
-            T *payload = nullptr;
-            explicit awaitable(::sigslot::signal<T&> & s) : signal(s) {
-                signal.connect(this, &awaitable::resolve);
-            }
-            awaitable(awaitable const & a) : signal(a.signal), payload(a.payload) {
-                signal.connect(this, &awaitable::resolve);
-            }
-            awaitable(awaitable && other) noexcept : signal(other.signal), payload(std::move(other.payload)) {
-                signal.connect(this, &awaitable::resolve);
+            // A copy whose function object, if it's on the heap, is allocated from resource
+            // instead of wherever the original's was.
+            _basic_inplace_function(_basic_inplace_function const & other, std::pmr::memory_resource * resource)
+                    : m_invoke(other.m_invoke), m_manage(other.m_manage)
+            {
+                transfer(op::copy, const_cast<unsigned char *>(other.m_storage), resource);
             }
 
-            bool await_ready() {
-                return payload;
+            _basic_inplace_function & operator=(_basic_inplace_function && other) noexcept
+            {
+                if (this != &other) {
+                    if (m_manage) m_manage(op::destroy, m_storage, nullptr, nullptr);
+                    m_invoke = other.m_invoke;
+                    m_manage = other.m_manage;
+                    transfer(op::move, other.m_storage);
+                }
+                return *this;
             }
 
-            void await_suspend(std::coroutine_handle<> h) {
-                // The awaiting coroutine is already suspended.
-                awaiting = h;
-            }
+            _basic_inplace_function & operator=(_basic_inplace_function const &) = delete;
 
-            auto & await_resume() {
-                return *payload;
+            ~_basic_inplace_function()
+            {
+                if (m_manage) m_manage(op::destroy, m_storage, nullptr, nullptr);
             }
 
-            void resolve(T & a) {
-                payload = &a;
-                if (awaiting) ::sigslot::resume_switch(awaiting);
+            // Calls the function object with the caller's arguments. If consume is set, the
+            // arguments are forwarded as the signal's argument types, so by-value arguments
+            // are moved from; otherwise they're passed as lvalues, and copied only if the
+            // function object takes them by value.
+            R operator()(bool consume, _slot_arg<args>... a)
+            {
+                return m_invoke(m_storage, consume, a...);
             }
-        };
 
-        // Zero argument version uses nothing, of course.
-        template<>
-        struct awaitable<> : public has_slots {
-            ::sigslot::signal<> & signal;
-            std::coroutine_handle<> awaiting = nullptr;
-            bool ready = false;
-            explicit awaitable(::sigslot::signal<> & s) : signal(s) {
-                signal.connect(this, &awaitable::resolve);
-            }
-            awaitable(awaitable const & a) : signal(a.signal), ready(a.ready) {
-                signal.connect(this, &awaitable::resolve);
-            }
-            awaitable(awaitable && other) noexcept : signal(other.signal), ready(other.ready) {
-                signal.connect(this, &awaitable::resolve);
-            }
+        private:
+            enum class op { move, copy, destroy };
 
-            bool await_ready() {
-                return ready;
-            }
+            // What's stored in place of a function object on the heap.
+            template<typename F>
+            struct heap_ref {
+                F * f;
+                std::pmr::memory_resource * resource;
+            };
 
-            void await_suspend(std::coroutine_handle<> h) {
-                // The awaiting coroutine is already suspended.
-                awaiting = h;
+            template<typename F>
+            static R invoke(F & f, bool consume, _slot_arg<args>... a)
+            {
+                if constexpr (_can_consume<args...>) {
+                    if (consume) return static_cast<R>(f(std::forward<args>(a)...));
+                }
+                return static_cast<R>(f(a...));
             }
 
-            void await_resume() {}
-
-            void resolve() {
-                ready = true;
-                if (awaiting) ::sigslot::resume_switch(awaiting);
+            void transfer(op o, unsigned char * src, std::pmr::memory_resource * resource = nullptr)
+            {
+                if (m_manage) {
+                    m_manage(o, src, m_storage, resource);
+                } else {
+                    std::memcpy(m_storage, src, capacity);
+                }
             }
+
+            template<typename F>
+            static void manage_inplace(op o, void * src, void * dst, std::pmr::memory_resource *)
+            {
+                auto * f = std::launder(reinterpret_cast<F *>(src));
+                switch (o) {
+                    case op::move:
+                        // A moved-from _basic_inplace_function is only ever destroyed or assigned to,
+                        // so the moved-from F is left for that to clean up.
+                        ::new (dst) F(std::move(*f));
+                        break;
+                    case op::copy:
+                        if constexpr (std::is_copy_constructible_v<F>) {
+                            ::new (dst) F(*f);
+                        } else {
+                            throw std::logic_error("Slot function object cannot be copied");
+                        }
+                        break;
+                    case op::destroy:
+                        f->~F();
+                        break;
+                }
+            }
+
+            // Copies go to resource, if given, or otherwise wherever the original is.
+            template<typename F>
+            static void manage_heap(op o, void * src, void * dst, std::pmr::memory_resource * resource)
+            {
+                auto & ref = *std::launder(reinterpret_cast<heap_ref<F> *>(src));
+                switch (o) {
+                    case op::move:
+                        ::new (dst) heap_ref<F>(ref);
+                        ref.f = nullptr;
+                        break;
+                    case op::copy:
+                        if constexpr (std::is_copy_constructible_v<F>) {
+                            if (!resource) resource = ref.resource;
+                            std::pmr::polymorphic_allocator<> alloc(resource);
+                            ::new (dst) heap_ref<F>{alloc.template new_object<F>(*ref.f), resource};
+                        } else {
+                            throw std::logic_error("Slot function object cannot be copied");
+                        }
+                        break;
+                    case op::destroy:
+                        if (ref.f) std::pmr::polymorphic_allocator<>(ref.resource).delete_object(ref.f);
+                        break;
+                }
+            }
+
+            R (*m_invoke)(void *, bool, _slot_arg<args>...);
+            void (*m_manage)(op, void *, void *, std::pmr::memory_resource *) = nullptr;
+            alignas(std::max_align_t) unsigned char m_storage[capacity];
+        };
+
+        // What signals hold their slots in.
+        template<class R, class... args>
+        using _inplace_result_function = _basic_inplace_function<SIGSLOT_INPLACE_CAPACITY, R, args...>;
+
+        template<class... args>
+        using _inplace_function = _inplace_result_function<void, args...>;
+
+        // Where a basic_signal's connection lives: its index in either the slot vector, or the
+        // vector of connections made during emission.
+        // Allocated from the signal's memory resource, and freed back to it.
+        template<class mt_policy>
+        struct _slot_link : public _connection_link<mt_policy> {
+            _slot_link(_signal_base_lo<mt_policy> * s, basic_has_slots<mt_policy> * d, std::pmr::memory_resource * r)
+                    : _connection_link<mt_policy>(s, d), resource(r) {}
+
+            static _slot_link * create(_signal_base_lo<mt_policy> * s, basic_has_slots<mt_policy> * d, std::pmr::memory_resource * r)
+            {
+                return std::pmr::polymorphic_allocator<>(r).template new_object<_slot_link>(s, d, r);
+            }
+
+            std::size_t index = 0;
+            bool pending = false;
+            std::pmr::memory_resource * const resource;
+            // If the signal's instrumented.
+            _slot_stats * stats = nullptr;
+
+        protected:
+            void destroy() override
+            {
+                std::pmr::polymorphic_allocator<>(resource).delete_object(this);
+            }
+        };
+
+        template<class mt_policy, class R, class... args>
+        class _connection
+        {
+        public:
+            _connection(_slot_link<mt_policy> *link, _inplace_result_function<R, args...> && fn, bool once, int prio)
+                    : one_shot(once), priority(prio), m_link(link), m_fn(std::move(fn)) {}
+
+            R emit(bool consume, _slot_arg<args>... a)
+            {
+                return m_fn(consume, a...);
+            }
+
+            [[nodiscard]] basic_has_slots<mt_policy>* getdest() const
+            {
+                return m_link->dest;
+            }
+
+            [[nodiscard]] _slot_link<mt_policy>* link() const
+            {
+                return m_link;
+            }
+
+            bool one_shot = false;
+            bool expired = false;
+            bool blocked = false;
+            // Posted to an executor, through a _queued_slot.
+            bool queued = false;
+            int priority = 0;
+        private:
+            _slot_link<mt_policy>* m_link;
+            _inplace_result_function<R, args...> m_fn;
+
+            template<class, class, class...> friend class _signal_state;
         };
 
+        // Connections are held by value in a contiguous vector, so emission is a linear walk.
+        // The vector is kept in order of priority, highest first, and otherwise in the order
+        // the connections were made; new connections are inserted in place, without sorting.
+        // While any emission is running, the vector is never reallocated or reordered:
+        // removals just mark the connection expired (a tombstone), and new connections wait
+        // in m_pending_slots. Both are tidied up by compact() once the last emission ends.
+        // Each connection's link is kept up to date with its position, so breaking a
+        // connection never involves a search.
+        //
+        // Told whenever a signal loses a slot through its link - that is, not by the signal's
+        // own doing - with the signal's lock held.
+        struct _disconnect_listener {
+            virtual void disconnected() = 0;
+            virtual ~_disconnect_listener() = default;
+        };
+
+        // This is a signal's state, created when its first slot is connected, and kept until
+        // the signal is destroyed; links point here rather than at the signal itself.
+        // Slots return R, which is void for a plain signal. Everything allocated for a
+        // connection comes from the signal's memory resource, as does the state itself.
+        template<class mt_policy, class R, class... args>
+        class _signal_state : public _signal_base_lo<mt_policy>
+        {
+        public:
+            using has_slots_type = basic_has_slots<mt_policy>;
+            using connection_type = _connection<mt_policy, R, args...>;
+            using link_type = _slot_link<mt_policy>;
+            using _signal_base_lo<mt_policy>::m_barrier;
+
+            explicit _signal_state(std::pmr::memory_resource * resource)
+                    : m_connected_slots(resource), m_pending_slots(resource) {}
+
+            _signal_state(_signal_state const &) = delete;
+
+#ifndef SIGSLOT_NO_INSTRUMENTATION
+            ~_signal_state() override
+            {
+                delete m_stats.load();
+            }
+
+            // Starts recording statistics, or renames them if they're already being recorded.
+            void instrument(std::string name)
+            {
+                std::scoped_lock lock(m_barrier);
+                if (auto stats = m_stats.load()) {
+                    stats->rename(std::move(name));
+                    return;
+                }
+                auto stats = new _signal_stats(std::move(name));
+                for (auto const & slots : {&m_connected_slots, &m_pending_slots}) {
+                    for (auto & conn : *slots) {
+                        if (!conn.expired) conn.link()->stats = stats->add_slot(conn.getdest());
+                    }
+                }
+                m_stats.store(stats, std::memory_order_release);
+            }
+#endif
+
+            [[nodiscard]] _signal_stats * stats() const
+            {
+#ifndef SIGSLOT_NO_INSTRUMENTATION
+                return m_stats.load(std::memory_order_acquire);
+#else
+                return nullptr;
+#endif
+            }
+
+            static _signal_state * create(std::pmr::memory_resource * resource)
+            {
+                return std::pmr::polymorphic_allocator<>(resource).template new_object<_signal_state>(resource);
+            }
+
+            static void destroy(_signal_state * state)
+            {
+                std::pmr::polymorphic_allocator<>(state->resource()).delete_object(state);
+            }
+
+            [[nodiscard]] std::pmr::memory_resource * resource() const
+            {
+                return m_connected_slots.get_allocator().resource();
+            }
+
+            link_type * connect(has_slots_type * pclass, _inplace_result_function<R, args...> && slot, bool one_shot, int prio, bool queued = false)
+            {
+                std::scoped_lock lock{m_barrier};
+                connection_type conn(link_type::create(this, pclass, resource()), std::move(slot), one_shot, prio);
+                conn.queued = queued;
+                return add(std::move(conn));
+            }
+
+            // Connects the same slots as s, for those with a has_slots. Slots posted to an
+            // executor aren't copied: their _queued_slot, with its connection handle and
+            // one-shot state, belongs to the original connection alone.
+            void copy_from(_signal_state & s)
+            {
+                std::scoped_lock lock(m_barrier, s.m_barrier);
+                for (auto const & slots : {&s.m_connected_slots, &s.m_pending_slots}) {
+                    for (auto const & i : *slots) {
+                        // Connections without a has_slots belong to their handle, so stay put.
+                        if (i.expired || i.queued || !i.getdest()) continue;
+                        // Copied first, since copying a move-only slot throws.
+                        _inplace_result_function<R, args...> fn(i.m_fn, resource());
+                        connection_type conn(link_type::create(this, i.getdest(), resource()), std::move(fn), i.one_shot, i.priority);
+                        conn.blocked = conn.m_link->blocked = i.blocked;
+                        add(std::move(conn));
+                    }
+                }
+            }
+
+            void disconnect_all()
+            {
+                std::scoped_lock lock(m_barrier);
+                for (auto const & slots : {&m_connected_slots, &m_pending_slots}) {
+                    for (auto & i : *slots) {
+                        if (!i.expired) release(i);
+                    }
+                }
+                m_pending_slots.clear();
+                compact();
+                // Waiting coroutines are left waiting, as they would be on a signal that's gone.
+                while (m_waiters) {
+                    auto w = m_waiters;
+                    unlink(w);
+                    w->linked.store(false, std::memory_order_relaxed);
+                }
+            }
+
+            void disconnect(has_slots_type* pclass)
+            {
+                std::scoped_lock lock(m_barrier);
+                pclass->signal_disconnect_all(this);
+                compact();
+            }
+
+            bool slot_disconnect(_connection_link<mt_policy> * link) final
+            {
+                return slot_update(link, _slot_op::disconnect);
+            }
+
+            bool slot_update(_connection_link<mt_policy> * link, _slot_op op) final
+            {
+                std::unique_lock lock(m_barrier, std::try_to_lock);
+                if (!lock) return false;
+                auto l = static_cast<link_type *>(link);
+                auto & conn = l->pending ? m_pending_slots[l->index] : m_connected_slots[l->index];
+                if (op == _slot_op::disconnect) {
+                    release(conn);
+                    compact();
+                    if (m_disconnected) m_disconnected->disconnected();
+                } else {
+                    conn.blocked = (op == _slot_op::block);
+                }
+                return true;
+            }
+
+            // True if there are no slots or waiters left, and no emission is running.
+            bool idle()
+            {
+                std::scoped_lock lock{m_barrier};
+                return !m_emitting && m_connected_slots.empty() && m_pending_slots.empty() && !m_waiters;
+            }
+
+            // A coroutine waiting for the next emission. It lives in the coroutine frame, and
+            // is linked straight into the signal, so waiting allocates nothing. Waiters are
+            // woken in the order they started waiting, before any slots are called; those
+            // that start waiting during an emission wait for the next. wake() is called once
+            // the waiter is unlinked, and must clear linked before resuming anything.
+            struct waiter {
+                void (*wake)(waiter *, _slot_arg<args>...) = nullptr;
+                waiter * prev = nullptr;
+                waiter * next = nullptr;
+                std::uint64_t serial = 0;
+                std::atomic<bool> linked{false};
+            };
+
+            void wait(waiter * w)
+            {
+                std::scoped_lock lock{m_barrier};
+                w->serial = m_waiter_serial++;
+                w->prev = m_waiters_tail;
+                w->next = nullptr;
+                if (m_waiters_tail) m_waiters_tail->next = w; else m_waiters = w;
+                m_waiters_tail = w;
+                w->linked.store(true, std::memory_order_relaxed);
+            }
+
+            // Stops waiting, if it hasn't already been woken; returns true if it hadn't.
+            bool unwait(waiter * w)
+            {
+                std::scoped_lock lock{m_barrier};
+                if (!w->linked.load(std::memory_order_relaxed)) return false;
+                unlink(w);
+                w->linked.store(false, std::memory_order_relaxed);
+                return true;
+            }
+
+            // What an emission is recording: usually nothing, unless the signal's instrumented
+            // or tracing is on.
+            struct emission {
+                _signal_stats * stats;
+                bool traced;
+                std::string name;
+                _trace::clock::time_point start;
+
+                [[nodiscard]] bool recording() const
+                {
+                    return stats || traced;
+                }
+            };
+
+            emission begin_emission()
+            {
+                emission e{stats(), _trace::on(), {}, {}};
+                if (e.traced) [[unlikely]] {
+                    e.name = e.stats ? e.stats->name() : std::string();
+                    if (e.name.empty()) e.name = "emit";
+                    e.start = _trace::clock::now();
+                }
+                return e;
+            }
+
+            void end_emission(emission const & e)
+            {
+                if (e.traced) [[unlikely]] _trace::complete(_trace_category::signal, e.name, this, e.start);
+            }
+
+            // The emission loop. Calls call(conn, consume) for each slot in turn, skipping
+            // blocked and disconnected ones, until it returns false. One-shot slots are
+            // disconnected just before they're called, so a slot never reached stays connected.
+            // consume is true for the last slot that will be called (if it's called at all), and
+            // only ever if the arguments are worth moving from.
+            template<typename Call>
+            void dispatch(Call && call)
+            {
+                dispatch(std::forward<Call>(call), [](_signal_state &) {});
+            }
+
+            // As above, first calling wake(*this) if there are coroutines waiting.
+            template<typename Call, typename Wake>
+            void dispatch(Call && call, Wake && wake)
+            {
+                auto e = begin_emission();
+                auto lock = lock_for_emission(e.stats);
+                if (e.stats) [[unlikely]] e.stats->emitted();
+                if (m_waiters) [[unlikely]] wake(*this);
+                auto & slots = m_connected_slots;
+                auto end = slots.size();
+                auto last = end;
+                if constexpr (_can_consume<args...>) {
+                    // Blocked slots still count, since an earlier slot may unblock them.
+                    while (last != 0 && slots[last - 1].expired) --last;
+                } else {
+                    last = 0;
+                }
+                ++m_emitting;
+                try {
+                    for (std::size_t i = 0; i != end; ++i) {
+                        auto & conn = slots[i];
+                        if (conn.expired || conn.blocked) continue;
+                        if (!call_slot(e, conn, [&call, &conn, consume = (i + 1 == last)]() { return call(conn, consume); })) break;
+                    }
+                } catch (...) {
+                    --m_emitting;
+                    compact();
+                    end_emission(e);
+                    throw;
+                }
+                --m_emitting;
+                compact();
+                end_emission(e);
+            }
+
+            // Takes the lock, timing the wait if the signal's instrumented.
+            std::unique_lock<mt_policy> lock_for_emission(_signal_stats * stats)
+            {
+                if (!stats) [[likely]] return std::unique_lock(m_barrier);
+                std::unique_lock lock(m_barrier, std::try_to_lock);
+                if (lock) {
+                    stats->waited({});
+                } else {
+                    auto start = _signal_stats::clock::now();
+                    lock.lock();
+                    stats->waited(_signal_stats::clock::now() - start);
+                }
+                return lock;
+            }
+
+            // Must be called with m_barrier held, as must the remaining members.
+
+            // Calls conn's slot through f, which returns whatever the slot's call does. A
+            // one-shot slot is disconnected first.
+            template<typename F>
+            auto call_slot(emission const & e, connection_type & conn, F && f)
+            {
+                if (e.recording()) [[unlikely]] {
+                    auto slot = conn.link()->stats;
+                    auto dest = conn.getdest();
+                    if (conn.one_shot) {
+                        release(conn);
+                        if (e.stats) e.stats->expired();
+                    }
+                    auto start = _signal_stats::clock::now();
+                    auto finished = [&]() {
+                        auto end = _signal_stats::clock::now();
+                        if (e.stats) e.stats->called(slot, end - start);
+                        if (e.traced) _trace::complete(_trace_category::slot, e.name, dest, start, end);
+                    };
+                    if constexpr (std::is_void_v<decltype(f())>) {
+                        f();
+                        finished();
+                        return;
+                    } else {
+                        auto r = f();
+                        finished();
+                        return r;
+                    }
+                }
+                if (conn.one_shot) release(conn);
+                return f();
+            }
+
+            link_type * add(connection_type && conn)
+            {
+                auto link = conn.link();
+                if (auto stats = this->stats()) [[unlikely]] link->stats = stats->add_slot(link->dest);
+                if (m_emitting) {
+                    link->index = m_pending_slots.size();
+                    link->pending = true;
+                    m_pending_slots.push_back(std::move(conn));
+                } else {
+                    auto & slots = m_connected_slots;
+                    link->pending = false;
+                    if (slots.empty() || slots.back().priority >= conn.priority) {
+                        link->index = slots.size();
+                        slots.push_back(std::move(conn));
+                    } else {
+                        auto pos = std::upper_bound(slots.begin(), slots.end(), conn.priority,
+                                                    [](int prio, connection_type const & c) { return prio > c.priority; });
+                        auto index = static_cast<std::size_t>(pos - slots.begin());
+                        slots.insert(pos, std::move(conn));
+                        reindex(index);
+                    }
+                }
+                if (link->dest) link->dest->signal_connect(link);
+                return link;
+            }
+
+            // Breaks the connection, leaving a tombstone.
+            void release(connection_type & conn)
+            {
+                auto link = conn.link();
+                _signal_stats::remove_slot(link->stats);
+                link->detach();
+                link->unref();
+                conn.m_link = nullptr;
+                conn.expired = m_tombstones = true;
+            }
+
+            // Sweeps out tombstones and appends connections made during emission.
+            // A no-op while emitting.
+            void compact()
+            {
+                if (m_emitting) return;
+                if (m_tombstones) {
+                    std::size_t w = 0;
+                    for (std::size_t r = 0; r != m_connected_slots.size(); ++r) {
+                        auto & conn = m_connected_slots[r];
+                        if (conn.expired) continue;
+                        if (w != r) m_connected_slots[w] = std::move(conn);
+                        m_connected_slots[w].link()->index = w;
+                        ++w;
+                    }
+                    m_connected_slots.erase(m_connected_slots.begin() + w, m_connected_slots.end());
+                    m_tombstones = false;
+                    if (auto stats = this->stats()) [[unlikely]] stats->sweep();
+                }
+                if (!m_pending_slots.empty()) {
+                    auto by_priority = [](connection_type const & a, connection_type const & b) {
+                        return a.priority > b.priority;
+                    };
+                    auto mid = m_connected_slots.size();
+                    for (auto & conn : m_pending_slots) {
+                        if (conn.expired) continue;
+                        conn.link()->pending = false;
+                        m_connected_slots.push_back(std::move(conn));
+                    }
+                    m_pending_slots.clear();
+                    auto first = m_connected_slots.begin() + mid;
+                    std::stable_sort(first, m_connected_slots.end(), by_priority);
+                    if (mid != 0 && first != m_connected_slots.end() && by_priority(*first, *(first - 1))) {
+                        std::inplace_merge(m_connected_slots.begin(), first, m_connected_slots.end(), by_priority);
+                        mid = 0;
+                    }
+                    reindex(mid);
+                }
+            }
+
+            // Wakes the coroutines that were waiting when the emission started.
+            void wake(_slot_arg<args>... a)
+            {
+                auto limit = m_waiter_serial;
+                while (m_waiters && m_waiters->serial < limit) {
+                    auto w = m_waiters;
+                    unlink(w);
+                    w->wake(w, a...);
+                }
+            }
+
+            [[nodiscard]] bool waiting() const
+            {
+                return m_waiters;
+            }
+
+            void unlink(waiter * w)
+            {
+                if (w->prev) w->prev->next = w->next; else m_waiters = w->next;
+                if (w->next) w->next->prev = w->prev; else m_waiters_tail = w->prev;
+            }
+
+            void reindex(std::size_t from)
+            {
+                for (auto i = from; i != m_connected_slots.size(); ++i) {
+                    auto & conn = m_connected_slots[i];
+                    if (!conn.expired) conn.link()->index = i;
+                }
+            }
+
+            std::pmr::vector<connection_type>  m_connected_slots;
+            std::pmr::vector<connection_type>  m_pending_slots;
+            std::size_t m_emitting = 0;
+            bool m_tombstones = false;
+            waiter * m_waiters = nullptr;
+            waiter * m_waiters_tail = nullptr;
+            std::uint64_t m_waiter_serial = 0;
+            _disconnect_listener * m_disconnected = nullptr;
+#ifndef SIGSLOT_NO_INSTRUMENTATION
+            std::atomic<_signal_stats *> m_stats = nullptr;
+#endif
+        };
+
+        // What a signal holds: a word, pointing at its state once it has any. A signal
+        // that's never connected allocates nothing, and holds no lock.
+        template<class mt_policy, class R, class... args>
+        class _signal_base
+        {
+        public:
+            using has_slots_type = basic_has_slots<mt_policy>;
+            using connection_handle = basic_connection<mt_policy>;
+            using state_type = _signal_state<mt_policy, R, args...>;
+            using connection_type = typename state_type::connection_type;
+
+            _signal_base() : _signal_base(std::pmr::get_default_resource()) {}
+
+            explicit _signal_base(std::pmr::memory_resource * resource) : m_state(resource) {}
+
+            // As with the std::pmr containers, a copy uses the default memory resource. It has
+            // the same slots as s, but only those with a has_slots, and not posted to executors.
+            _signal_base(const _signal_base& s) : _signal_base()
+            {
+                if (auto other = s.m_state.get()) m_state.get_or_create()->copy_from(*other);
+            }
+
+            _signal_base(_signal_base &&) = delete;
+
+            ~_signal_base()
+            {
+                if (auto state = m_state.get()) {
+                    state->disconnect_all();
+                    state_type::destroy(state);
+                }
+            }
+
+            // Connects a slot, disconnected when pclass is destroyed. A null pclass leaves the
+            // connection's lifetime entirely to the returned handle.
+            template<typename Fn>
+            requires std::is_invocable_r_v<R, std::decay_t<Fn> &, args...>
+            connection_handle connect(has_slots_type *pclass, Fn &&fn, bool one_shot = false, priority prio = {})
+            {
+                _inplace_result_function<R, args...> slot(std::forward<Fn>(fn), resource());
+                return connection_handle(m_state.get_or_create()->connect(pclass, std::move(slot), one_shot, prio.value));
+            }
+
+            // Helper for ptr-to-member; call the member function "normally".
+            template<class desttype>
+            requires std::derived_from<desttype, has_slots_type>
+            connection_handle connect(desttype *pclass, R (desttype::* memfn)(args...), bool one_shot = false, priority prio = {})
+            {
+                return this->connect(pclass, [pclass, memfn](auto &&... a) -> R { return (pclass->*memfn)(std::forward<decltype(a)>(a)...); }, one_shot, prio);
+            }
+
+            // As above, but with the member function fixed at compile time, as in
+            // signal.connect<&Sink::slot>(&sink). The connection holds only the object pointer,
+            // and emission calls the member directly, so it can be inlined.
+            template<auto memfn, class desttype>
+            requires std::derived_from<desttype, has_slots_type> && std::is_invocable_r_v<R, decltype(memfn), desttype *, args...>
+            connection_handle connect(desttype *pclass, bool one_shot = false, priority prio = {})
+            {
+                return this->connect(pclass, [pclass](auto &&... a) -> R { return (pclass->*memfn)(std::forward<decltype(a)>(a)...); }, one_shot, prio);
+            }
+
+            // With no has_slots, the slot stays connected for as long as the returned
+            // scoped_connection is in scope.
+            template<typename Fn>
+            requires std::is_invocable_r_v<R, std::decay_t<Fn> &, args...>
+            [[nodiscard]] basic_scoped_connection<mt_policy> connect(Fn && fn, bool one_shot=false, priority prio = {})
+            {
+                return this->connect(nullptr, std::forward<Fn>(fn), one_shot, prio);
+            }
+
+            [[nodiscard]] std::pmr::memory_resource * resource() const
+            {
+                return m_state.resource();
+            }
+
+            void disconnect_all()
+            {
+                if (auto state = m_state.get()) state->disconnect_all();
+            }
+
+            void disconnect(has_slots_type* pclass)
+            {
+                if (auto state = m_state.get()) state->disconnect(pclass);
+            }
+
+#ifndef SIGSLOT_NO_INSTRUMENTATION
+            // Records statistics for this signal from now on, as gathered by
+            // sigslot::instrumentation::snapshot(), under name. Calling it again renames them.
+            void instrument(std::string name = {})
+            {
+                m_state.get_or_create()->instrument(std::move(name));
+            }
+
+            [[nodiscard]] bool instrumented() const
+            {
+                auto state = m_state.get();
+                return state && state->stats();
+            }
+#endif
+
+        protected:
+            template<typename... Call>
+            void dispatch(Call &&... call)
+            {
+                if (auto state = m_state.get()) state->dispatch(std::forward<Call>(call)...);
+            }
+
+            [[nodiscard]] state_type * state() const
+            {
+                return m_state.get();
+            }
+
+            [[nodiscard]] state_type * state_or_create()
+            {
+                return m_state.get_or_create();
+            }
+
+        private:
+            _lazy_state<mt_policy, state_type> m_state;
+        };
+
+    }
+
+
+#ifndef SIGSLOT_NO_COROUTINES
+    namespace coroutines {
+        template<class mt_policy, class... args> struct awaitable;
+    }
+
+    // What a signal's stream (see sigslot/stream.h) does with an emission that arrives while
+    // its buffer is full.
+    enum class stream_overflow {
+        drop_oldest,    // Make room by discarding the oldest, and count it in dropped().
+        drop_newest,    // Discard the new one, and count it in dropped().
+        grow,           // Keep it beyond capacity, and count it in overflowed().
+    };
+
+    template<class mt_policy, class... args> class basic_signal_stream;
+#endif
+
+    // The order emit_many() calls slots in. slot_major calls each slot for every event in
+    // turn, which keeps the slot's code hot; event_major calls every slot for one event
+    // before moving on to the next, just as a loop of emit() calls would.
+    enum class emit_order { slot_major, event_major };
+
+    // A vector that keeps its first N elements in place, only going to the heap beyond that.
+    // Just enough of one for collecting the results of an emission.
+    template<class T, std::size_t N>
+    class small_vector
+    {
+    public:
+        small_vector() = default;
+
+        small_vector(small_vector const & other)
+        {
+            for (auto const & v : other) push_back(v);
+        }
+
+        small_vector(small_vector && other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            take(std::move(other));
+        }
+
+        small_vector & operator=(small_vector const & other)
+        {
+            if (this != &other) {
+                clear();
+                for (auto const & v : other) push_back(v);
+            }
+            return *this;
+        }
+
+        small_vector & operator=(small_vector && other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this != &other) {
+                reset();
+                take(std::move(other));
+            }
+            return *this;
+        }
+
+        ~small_vector()
+        {
+            reset();
+        }
+
+        template<typename... A>
+        T & emplace_back(A &&... a)
+        {
+            if (m_size == m_capacity) grow();
+            auto p = ::new (static_cast<void *>(data() + m_size)) T(std::forward<A>(a)...);
+            ++m_size;
+            return *p;
+        }
+
+        void push_back(T const & v)
+        {
+            emplace_back(v);
+        }
+
+        void push_back(T && v)
+        {
+            emplace_back(std::move(v));
+        }
+
+        void clear()
+        {
+            std::destroy_n(data(), m_size);
+            m_size = 0;
+        }
+
+        [[nodiscard]] T * data()
+        {
+            return m_heap ? m_heap : std::launder(reinterpret_cast<T *>(m_inline));
+        }
+
+        [[nodiscard]] T const * data() const
+        {
+            return m_heap ? m_heap : std::launder(reinterpret_cast<T const *>(m_inline));
+        }
+
+        [[nodiscard]] std::size_t size() const { return m_size; }
+        [[nodiscard]] bool empty() const { return m_size == 0; }
+        [[nodiscard]] bool is_inline() const { return !m_heap; }
+
+        T & operator[](std::size_t i) { return data()[i]; }
+        T const & operator[](std::size_t i) const { return data()[i]; }
+
+        T * begin() { return data(); }
+        T * end() { return data() + m_size; }
+        T const * begin() const { return data(); }
+        T const * end() const { return data() + m_size; }
+
+    private:
+        void grow()
+        {
+            auto capacity = m_capacity * 2;
+            auto heap = std::allocator<T>().allocate(capacity);
+            std::uninitialized_move_n(data(), m_size, heap);
+            std::destroy_n(data(), m_size);
+            if (m_heap) std::allocator<T>().deallocate(m_heap, m_capacity);
+            m_heap = heap;
+            m_capacity = capacity;
+        }
+
+        // Leaves the vector empty, with no heap storage.
+        void reset()
+        {
+            clear();
+            if (m_heap) std::allocator<T>().deallocate(m_heap, m_capacity);
+            m_heap = nullptr;
+            m_capacity = N;
+        }
+
+        void take(small_vector && other)
+        {
+            if (other.m_heap) {
+                m_heap = std::exchange(other.m_heap, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+                m_capacity = std::exchange(other.m_capacity, N);
+            } else {
+                for (auto & v : other) emplace_back(std::move(v));
+                other.clear();
+            }
+        }
+
+        alignas(T) unsigned char m_inline[N * sizeof(T)];
+        T * m_heap = nullptr;
+        std::size_t m_size = 0;
+        std::size_t m_capacity = N;
+    };
+
+    // Combiners for signals whose slots return a value, as in signal<bool(Message &)>. Each
+    // is given the slots' results in turn, and returns false once it has seen enough, at
+    // which point emission stops, and the remaining slots aren't called. Anything with a
+    // bool operator()(R &&) and a result() works as a combiner.
+    namespace combiners {
+        // The first result that tests true, such as a non-null pointer or an engaged
+        // optional; otherwise, a default-constructed R.
+        template<class R>
+        class first_non_empty {
+        public:
+            bool operator()(R && r)
+            {
+                if (!r) return true;
+                m_result = std::move(r);
+                return false;
+            }
+
+            R result() && { return std::move(m_result); }
+
+        private:
+            R m_result{};
+        };
+
+        // Whether every slot returned true; stops at the first that doesn't. True if there
+        // are no slots.
+        template<class R>
+        class all_true {
+        public:
+            bool operator()(R && r)
+            {
+                m_result = static_cast<bool>(r);
+                return m_result;
+            }
+
+            bool result() && { return m_result; }
+
+        private:
+            bool m_result = true;
+        };
+
+        template<class R>
+        class sum {
+        public:
+            bool operator()(R && r)
+            {
+                m_result += std::move(r);
+                return true;
+            }
+
+            R result() && { return std::move(m_result); }
+
+        private:
+            R m_result{};
+        };
+
+        // The greatest result, or nothing if no slots were called.
+        template<class R>
+        class maximum {
+        public:
+            bool operator()(R && r)
+            {
+                if (!m_result || *m_result < r) m_result = std::move(r);
+                return true;
+            }
+
+            std::optional<R> result() && { return std::move(m_result); }
+
+        private:
+            std::optional<R> m_result;
+        };
+
+        // Every result, in the order the slots were called.
+        template<class R, std::size_t N = 8>
+        class collect {
+        public:
+            bool operator()(R && r)
+            {
+                m_result.push_back(std::move(r));
+                return true;
+            }
+
+            small_vector<R, N> result() && { return std::move(m_result); }
+
+        private:
+            small_vector<R, N> m_result;
+        };
+    }
+
+
+    template<class mt_policy, class... args>
+    class basic_signal : public internal::_signal_base<mt_policy, void, args...>
+    {
+        using base = internal::_signal_base<mt_policy, void, args...>;
+    public:
+        using has_slots_type = basic_has_slots<mt_policy>;
+        using connection_handle = basic_connection<mt_policy>;
+
+        basic_signal() = default;
+
+        explicit basic_signal(std::pmr::memory_resource * resource) : base(resource) {}
+
+        basic_signal(const basic_signal& s) = default;
+
+        using base::connect;
+
+        // Connects a slot to be called through an executor, such as a sigslot::dispatcher,
+        // rather than during emission; each emission copies (or moves) the arguments into a
+        // call posted to it. References among the arguments are not kept, so can't be used
+        // to pass anything back. Calls made after pclass is destroyed, or the connection is
+        // broken, are skipped, and pclass's destructor waits for calls already running on
+        // other threads. A one-shot slot is disconnected as its call is made (or, if another
+        // thread is emitting the signal just then, by the signal's next emission).
+        // An executor passed as an lvalue must outlive the connection; otherwise it's copied.
+        // Copying the signal doesn't copy the connection.
+        template<typename Fn, executor Executor>
+        requires std::invocable<std::decay_t<Fn> &, args...>
+        connection_handle connect(has_slots_type *pclass, Fn &&fn, Executor && exec, bool one_shot = false, priority prio = {})
+        {
+            using queued_slot = internal::_queued_slot<mt_policy, std::decay_t<Fn>, Executor>;
+            auto slot = std::allocate_shared<queued_slot>(std::pmr::polymorphic_allocator<queued_slot>(this->resource()),
+                                                          std::forward<Fn>(fn), std::forward<Executor>(exec),
+                                                          pclass ? pclass->liveness() : nullptr, one_shot);
+            internal::_inplace_function<args...> trampoline(queued_slot::template trampoline<true, args...>(slot), this->resource());
+            auto state = this->state_or_create();
+            // Hold the lock until the handle's in place, so no call can be made without it.
+            std::scoped_lock lock{state->m_barrier};
+            slot->conn = connection_handle(state->connect(pclass, std::move(trampoline), false, prio.value, true));
+            return slot->conn;
+        }
+
+        template<class desttype, executor Executor>
+        requires std::derived_from<desttype, has_slots_type>
+        connection_handle connect(desttype *pclass, void (desttype::* memfn)(args...), Executor && exec, bool one_shot = false, priority prio = {})
+        {
+            return this->connect(pclass, [pclass, memfn](auto &&... a) { (pclass->*memfn)(std::forward<decltype(a)>(a)...); }, std::forward<Executor>(exec), one_shot, prio);
+        }
+
+        template<auto memfn, class desttype, executor Executor>
+        requires std::derived_from<desttype, has_slots_type> && std::invocable<decltype(memfn), desttype *, args...>
+        connection_handle connect(desttype *pclass, Executor && exec, bool one_shot = false, priority prio = {})
+        {
+            return this->connect(pclass, [pclass](auto &&... a) { (pclass->*memfn)(std::forward<decltype(a)>(a)...); }, std::forward<Executor>(exec), one_shot, prio);
+        }
+
+        // Slots connected during emission are not called until the next emit; slots
+        // disconnected during emission are skipped if they haven't been called yet.
+        // Each slot gets the arguments as lvalues, except the last, which may move from them.
+        void emit(args... a)
+        {
+            this->dispatch([&a...](auto & conn, bool consume) {
+                conn.emit(consume, a...);
+                return true;
+            }, [&a...](auto & state) {
+                state.wake(a...);
+            });
+        }
+
+        void operator()(args... a)
+        {
+            this->emit(std::forward<args>(a)...);
+        }
+
+        // Emits once for each element of events, taking the lock and tidying up afterwards
+        // just once for the whole batch. Elements are tuples of the arguments (or, for a
+        // signal with a single argument, the argument itself), and are passed to the slots as
+        // lvalues, so by-value arguments need a mutable range. One-shot slots are called for
+        // the first event only. In slot_major order, a slot disconnected by another slot
+        // misses the whole batch if it hadn't been reached yet. Input ranges that can only
+        // be walked once are always emitted in event_major order.
+        template<std::ranges::input_range R>
+        void emit_many(R && events, emit_order order = emit_order::slot_major)
+        {
+            auto state = this->state();
+            if (!state) return;
+            auto e = state->begin_emission();
+            auto stats = e.stats;
+            auto lock = state->lock_for_emission(stats);
+            auto & slots = state->m_connected_slots;
+            auto end = slots.size();
+            ++state->m_emitting;
+            try {
+                // Waiting coroutines get the first event, just as one-shot slots do.
+                bool wake = state->waiting();
+                if (order == emit_order::event_major || !std::ranges::forward_range<R>) {
+                    for (auto && event : events) {
+                        if (wake) [[unlikely]] {
+                            wake_event(*state, event);
+                            wake = false;
+                        }
+                        if (stats) [[unlikely]] stats->emitted();
+                        for (std::size_t i = 0; i != end; ++i) {
+                            auto & conn = slots[i];
+                            if (conn.expired || conn.blocked) continue;
+                            state->call_slot(e, conn, [&conn, &event]() { emit_event(conn, event); });
+                        }
+                    }
+                } else if constexpr (std::ranges::forward_range<R>) {
+                    if (wake) [[unlikely]] {
+                        for (auto && event : events) {
+                            wake_event(*state, event);
+                            break;
+                        }
+                    }
+                    if (stats) [[unlikely]] stats->emitted(static_cast<std::uint64_t>(std::ranges::distance(events)));
+                    for (std::size_t i = 0; i != end; ++i) {
+                        auto & conn = slots[i];
+                        for (auto && event : events) {
+                            if (conn.expired || conn.blocked) break;
+                            state->call_slot(e, conn, [&conn, &event]() { emit_event(conn, event); });
+                        }
+                    }
+                }
+            } catch (...) {
+                --state->m_emitting;
+                state->compact();
+                state->end_emission(e);
+                throw;
+            }
+            --state->m_emitting;
+            state->compact();
+            state->end_emission(e);
+        }
+
+#ifndef SIGSLOT_NO_COROUTINES
+        auto operator co_await() const {
+            return coroutines::awaitable<mt_policy, args...>(*const_cast<basic_signal &>(*this).state_or_create());
+        }
+
+        // A buffered subscription, holding up to capacity emissions for a coroutine to
+        // take in its own time. Needs sigslot/stream.h.
+        basic_signal_stream<mt_policy, args...> stream(std::size_t capacity, stream_overflow policy = stream_overflow::drop_oldest)
+        {
+            return basic_signal_stream<mt_policy, args...>(*this, capacity, policy);
+        }
+#endif
+
+    private:
+        template<class E>
+        static void wake_event(typename base::state_type & state, E & event)
+        {
+            if constexpr (requires { state.wake(event); }) {
+                state.wake(event);
+            } else {
+                std::apply([&state](auto &... a) { state.wake(a...); }, event);
+            }
+        }
+
+        template<class E>
+        static void emit_event(typename base::connection_type & conn, E & event)
+        {
+            if constexpr (requires { conn.emit(false, event); }) {
+                conn.emit(false, event);
+            } else {
+                std::apply([&conn](auto &... a) { conn.emit(false, a...); }, event);
+            }
+        }
+    };
+
+    // A signal whose slots return a value, as in signal<bool(Message &)>. Emitting gives
+    // the slots' results to a combiner, which can stop the emission early; the slots it
+    // didn't need aren't called, and one-shot slots among them stay connected. Otherwise,
+    // it behaves just as a plain signal does.
+    template<class mt_policy, class R, class... args>
+    class basic_signal<mt_policy, R(args...)> : public internal::_signal_base<mt_policy, R, args...>
+    {
+        static_assert(!std::is_void_v<R>, "Slots with no result need a plain signal<args...>");
+        using base = internal::_signal_base<mt_policy, R, args...>;
+    public:
+        using has_slots_type = basic_has_slots<mt_policy>;
+        using connection_handle = basic_connection<mt_policy>;
+        using result_type = R;
+
+        basic_signal() = default;
+
+        explicit basic_signal(std::pmr::memory_resource * resource) : base(resource) {}
+
+        basic_signal(const basic_signal& s) = default;
+
+        using base::connect;
+
+        // Emits, and returns the combiner's result.
+        template<class Combiner>
+        requires std::predicate<Combiner &, R &&>
+        auto combine(Combiner combiner, args... a)
+        {
+            this->dispatch([&combiner, &a...](auto & conn, bool consume) {
+                return static_cast<bool>(combiner(conn.emit(consume, a...)));
+            });
+            return std::move(combiner).result();
+        }
+
+        // As above, with one of the combiners above (or any with the same shape), as in
+        // signal.template emit<sigslot::combiners::first_non_empty>(msg). By default, the
+        // results are collected.
+        template<template<class> class Combiner = combiners::collect>
+        auto emit(args... a)
+        {
+            return this->combine(Combiner<R>{}, std::forward<args>(a)...);
+        }
+
+        auto operator()(args... a)
+        {
+            return this->emit(std::forward<args>(a)...);
+        }
+    };
+
+    template<class... args>
+    using signal = basic_signal<SIGSLOT_DEFAULT_MT_POLICY, args...>;
+
+    // The single-threaded family: no locking at all.
+    namespace st {
+        using has_slots = basic_has_slots<single_threaded>;
+        using connection = basic_connection<single_threaded>;
+        using scoped_connection = basic_scoped_connection<single_threaded>;
+
+        template<class... args>
+        using signal = basic_signal<single_threaded, args...>;
+    }
+
+
+#ifndef SIGSLOT_NO_COROUTINES
+    namespace coroutines {
+        // What co_await on a signal waits with: one of the signal's waiters, living in the
+        // coroutine frame. It resolves to nothing (ie, void), the single argument (a
+        // reference, if the argument is one), or a std::tuple of the arguments.
+        template<class mt_policy, typename... Args>
+        struct awaitable : public internal::_signal_state<mt_policy, void, Args...>::waiter {
+            using state_type = internal::_signal_state<mt_policy, void, Args...>;
+            using payload_type = std::tuple<Args...>;
+
+            state_type & signal;
+            std::coroutine_handle<> awaiting = nullptr;
+            std::optional<payload_type> payload;
+
+            explicit awaitable(state_type & s) : signal(s) {
+                this->wake = &awaitable::resolve;
+            }
+            // Only ever copied before it's waiting.
+            awaitable(awaitable const & a) : signal(a.signal), payload(a.payload) {
+                this->wake = &awaitable::resolve;
+            }
+
+            ~awaitable() {
+                if (this->linked.load(std::memory_order_acquire)) signal.unwait(this);
+            }
+
+            bool await_ready() {
+                return payload.has_value();
+            }
+
+            // Only starts waiting once suspended, so an emission on another thread can
+            // resume the coroutine straight away.
+            void await_suspend(std::coroutine_handle<> h) {
+                awaiting = h;
+                signal.wait(this);
+            }
+
+            decltype(auto) await_resume() {
+                if constexpr (sizeof...(Args) == 0) {
+                    return;
+                } else if constexpr (sizeof...(Args) == 1) {
+                    return std::tuple_element_t<0, payload_type>(std::get<0>(std::move(*payload)));
+                } else {
+                    return std::move(*payload);
+                }
+            }
+
+            // Stops waiting, unless an emission has already woken the coroutine. Returns true
+            // if it stopped, in which case the signal will never resume the coroutine.
+            bool cancel() {
+                return signal.unwait(this);
+            }
+
+            static void resolve(typename state_type::waiter * w, internal::_slot_arg<Args>... a) {
+                auto self = static_cast<awaitable *>(w);
+                self->payload.emplace(a...);
+                // Once unlinked, the coroutine may be destroyed without waiting for us.
+                auto awaiting = self->awaiting;
+                self->linked.store(false, std::memory_order_release);
+                ::sigslot::resume_switch(awaiting);
+            }
+        };
     }
 #endif
 } // namespace sigslot
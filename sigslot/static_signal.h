@@ -0,0 +1,358 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#ifndef SIGSLOT_STATIC_SIGNAL_H
+#define SIGSLOT_STATIC_SIGNAL_H
+
+#include <sigslot/sigslot.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+namespace sigslot {
+    // How a static_signal passes each argument to its slot functions: by value for small,
+    // trivially copyable types (no bigger than two pointers), and by reference otherwise,
+    // keeping any const. So a slot function for static_signal<N, int, std::string,
+    // Msg const &> has the signature void(void * ctx, int, std::string &, Msg const &).
+    template<class T>
+    using static_slot_arg = internal::_slot_arg<T>;
+
+    // A signal with room for at most N slots, held inside the object itself, so that neither
+    // connecting, disconnecting nor emitting ever allocates. Each slot is a plain function
+    // pointer and a context pointer to pass it - connect<&Sink::slot>(&sink) makes one from a
+    // member function - rather than an arbitrary function object.
+    //
+    // Once N slots are connected, connect() returns false, and connects nothing. Slots
+    // disconnected during an emission only free their place once it has finished.
+    //
+    // Otherwise, it behaves much as a signal does: slots are called in the order they were
+    // connected, those connected during an emission wait for the next, one-shot slots are
+    // disconnected as they're called, and slots are disconnected when their has_slots is
+    // destroyed. (A has_slots allocates its own bookkeeping on its first connection to
+    // anything, so connect those before allocation is off limits.) There are no
+    // connection handles, priorities, executors or statistics.
+    //
+    // Coroutines can co_await it just as they can a signal. The awaiter takes one of the N
+    // places while it waits, and throws std::length_error if there are none.
+    template<class mt_policy, std::size_t N, class... args>
+    class basic_static_signal : public internal::_signal_base_lo<mt_policy>
+    {
+    public:
+        using has_slots_type = basic_has_slots<mt_policy>;
+        using slot_function = void (*)(void *, static_slot_arg<args>...);
+
+    private:
+        using link_type = internal::_connection_link<mt_policy>;
+
+        // Lives in its slot, so there's nothing to free; once the last reference has gone,
+        // the slot's place can be used again.
+        struct static_link : public link_type {
+            static_link(basic_static_signal * s, has_slots_type * d, std::size_t i) : link_type(s, d), index(i) {}
+
+            [[nodiscard]] bool released() const
+            {
+                return m_released.load(std::memory_order_acquire);
+            }
+
+            std::size_t index;
+
+        protected:
+            void destroy() override
+            {
+                m_released.store(true, std::memory_order_release);
+            }
+
+        private:
+            std::atomic<bool> m_released{false};
+        };
+
+        // An expired slot is disconnected, but may still be called by an emission that's
+        // running; a retired one has been dropped from the call order, but a has_slots
+        // disconnecting it still holds a reference to its link.
+        enum class slot_state : char { free, connected, expired, retired };
+
+        struct slot {
+            slot_function fn = nullptr;
+            void * ctx = nullptr;
+            slot_state state = slot_state::free;
+            bool one_shot = false;
+            bool blocked = false;
+            std::optional<static_link> link;
+        };
+
+    public:
+        basic_static_signal() = default;
+        basic_static_signal(basic_static_signal const &) = delete;
+        basic_static_signal(basic_static_signal &&) = delete;
+
+        ~basic_static_signal() override
+        {
+            disconnect_all();
+            // A has_slots may still be finishing with a link it has just disconnected.
+            for (auto & s : m_slots) {
+                while (s.state == slot_state::retired && !s.link->released()) std::this_thread::yield();
+            }
+        }
+
+        [[nodiscard]] static constexpr std::size_t capacity()
+        {
+            return N;
+        }
+
+        // Slots connected, or disconnected during an emission that's still running.
+        [[nodiscard]] std::size_t size()
+        {
+            std::scoped_lock lock(m_barrier);
+            return m_count;
+        }
+
+        // Connects fn, to be called with ctx, and disconnected when pclass (if any) is
+        // destroyed. Returns false if there's no room.
+        [[nodiscard]] bool connect(has_slots_type * pclass, slot_function fn, void * ctx, bool one_shot = false)
+        {
+            std::scoped_lock lock(m_barrier);
+            if (m_count == N) return false;
+            std::size_t i = 0;
+            for (; i != N; ++i) {
+                auto & s = m_slots[i];
+                if (s.state == slot_state::retired && s.link->released()) reclaim(s);
+                if (s.state == slot_state::free) break;
+            }
+            if (i == N) return false;
+            auto & s = m_slots[i];
+            s.fn = fn;
+            s.ctx = ctx;
+            s.state = slot_state::connected;
+            s.one_shot = one_shot;
+            s.blocked = false;
+            s.link.emplace(this, pclass, i);
+            if (pclass) pclass->signal_connect(&*s.link);
+            m_order[m_count++] = i;
+            if (!m_emitting) m_live = m_count;
+            return true;
+        }
+
+        template<auto memfn, class desttype>
+        requires std::derived_from<desttype, has_slots_type> && std::is_invocable_v<decltype(memfn), desttype *, args...>
+        [[nodiscard]] bool connect(desttype * pclass, bool one_shot = false)
+        {
+            return connect(pclass, &call_member<memfn, desttype>, pclass, one_shot);
+        }
+
+        void disconnect_all()
+        {
+            std::scoped_lock lock(m_barrier);
+            for (std::size_t n = 0; n != m_count; ++n) {
+                auto & s = m_slots[m_order[n]];
+                if (s.state == slot_state::connected) release(s);
+            }
+            compact();
+        }
+
+        void disconnect(has_slots_type * pclass)
+        {
+            std::scoped_lock lock(m_barrier);
+            pclass->signal_disconnect_all(this);
+            compact();
+        }
+
+        // Disconnects every slot connected with this function and context.
+        void disconnect(slot_function fn, void * ctx)
+        {
+            std::scoped_lock lock(m_barrier);
+            for (std::size_t n = 0; n != m_count; ++n) {
+                auto & s = m_slots[m_order[n]];
+                if (s.state == slot_state::connected && s.fn == fn && s.ctx == ctx) release(s);
+            }
+            compact();
+        }
+
+        bool slot_disconnect(link_type * link) final
+        {
+            return slot_update(link, internal::_slot_op::disconnect);
+        }
+
+        bool slot_update(link_type * link, internal::_slot_op op) final
+        {
+            std::unique_lock lock(m_barrier, std::try_to_lock);
+            if (!lock) return false;
+            auto & s = m_slots[static_cast<static_link *>(link)->index];
+            if (op == internal::_slot_op::disconnect) {
+                release(s);
+                compact();
+            } else {
+                s.blocked = (op == internal::_slot_op::block);
+            }
+            return true;
+        }
+
+        // Slots connected during emission are not called until the next emit; slots
+        // disconnected during emission are skipped if they haven't been called yet.
+        void emit(args... a)
+        {
+            std::scoped_lock lock(m_barrier);
+            ++m_emitting;
+            try {
+                for (std::size_t n = 0, last = m_live; n != last; ++n) {
+                    auto & s = m_slots[m_order[n]];
+                    if (s.state != slot_state::connected || s.blocked) continue;
+                    auto fn = s.fn;
+                    auto ctx = s.ctx;
+                    if (s.one_shot) release(s);
+                    fn(ctx, a...);
+                }
+            } catch (...) {
+                --m_emitting;
+                compact();
+                throw;
+            }
+            --m_emitting;
+            compact();
+        }
+
+        void operator()(args... a)
+        {
+            this->emit(std::forward<args>(a)...);
+        }
+
+#ifndef SIGSLOT_NO_COROUTINES
+        // Waits for the next emission, as a one-shot slot of its own.
+        class awaiter {
+        public:
+            explicit awaiter(basic_static_signal & signal) : m_signal(signal) {}
+            awaiter(awaiter const & other) : m_signal(other.m_signal) {}
+
+            ~awaiter()
+            {
+                if (m_waiting) m_signal.disconnect(&awaiter::resolve, this);
+            }
+
+            bool await_ready() const
+            {
+                return false;
+            }
+
+            // Connects only once suspended, so an emission on another thread can resume the
+            // coroutine straight away.
+            bool await_suspend(std::coroutine_handle<> h)
+            {
+                m_awaiting = h;
+                m_waiting = true;
+                if (m_signal.connect(nullptr, &awaiter::resolve, this, true)) return true;
+                m_waiting = false;
+                return false;
+            }
+
+            // Stops waiting, unless an emission has already resumed the coroutine. Returns true
+            // if it stopped.
+            bool cancel()
+            {
+                std::scoped_lock lock(m_signal.m_barrier);
+                if (!m_waiting.load()) return false;
+                m_signal.disconnect(&awaiter::resolve, this);
+                m_waiting.store(false);
+                return true;
+            }
+
+            decltype(auto) await_resume()
+            {
+                if (!m_payload) throw std::length_error("static_signal is full");
+                if constexpr (sizeof...(args) == 0) {
+                    return;
+                } else if constexpr (sizeof...(args) == 1) {
+                    return std::tuple_element_t<0, payload_type>(std::get<0>(std::move(*m_payload)));
+                } else {
+                    return std::move(*m_payload);
+                }
+            }
+
+        private:
+            using payload_type = std::tuple<args...>;
+
+            static void resolve(void * ctx, internal::_slot_arg<args>... a)
+            {
+                auto self = static_cast<awaiter *>(ctx);
+                self->m_payload.emplace(a...);
+                // Once no longer waiting, the coroutine may be destroyed without waiting for us.
+                auto awaiting = self->m_awaiting;
+                self->m_waiting.store(false);
+                ::sigslot::resume_switch(awaiting);
+            }
+
+            basic_static_signal & m_signal;
+            std::coroutine_handle<> m_awaiting;
+            std::optional<payload_type> m_payload;
+            std::atomic<bool> m_waiting{false};
+        };
+
+        awaiter operator co_await()
+        {
+            return awaiter(*this);
+        }
+#endif
+
+    private:
+        template<auto memfn, class desttype>
+        static void call_member(void * ctx, internal::_slot_arg<args>... a)
+        {
+            (static_cast<desttype *>(ctx)->*memfn)(a...);
+        }
+
+        // The remaining members must be called with m_barrier held.
+
+        // Drops the signal's reference to the link; its place is freed once no-one else holds one.
+        void release(slot & s)
+        {
+            s.link->detach();
+            s.link->unref();
+            s.state = slot_state::expired;
+        }
+
+        void reclaim(slot & s)
+        {
+            s.link.reset();
+            s.state = slot_state::free;
+        }
+
+        // Drops expired slots from the call order, keeping the rest in order, and frees their
+        // places if their links have been released. A no-op while emitting.
+        void compact()
+        {
+            if (m_emitting) return;
+            std::size_t w = 0;
+            for (std::size_t r = 0; r != m_count; ++r) {
+                auto i = m_order[r];
+                auto & s = m_slots[i];
+                if (s.state == slot_state::expired) {
+                    if (s.link->released()) reclaim(s); else s.state = slot_state::retired;
+                    continue;
+                }
+                m_order[w++] = i;
+            }
+            m_count = m_live = w;
+        }
+
+        using internal::_signal_base_lo<mt_policy>::m_barrier;
+        std::array<slot, N> m_slots;
+        // The slots in the order they were connected; the first m_live are called by emit.
+        std::array<std::size_t, N> m_order{};
+        std::size_t m_count = 0;
+        std::size_t m_live = 0;
+        unsigned m_emitting = 0;
+    };
+
+    template<std::size_t N, class... args>
+    using static_signal = basic_static_signal<SIGSLOT_DEFAULT_MT_POLICY, N, args...>;
+
+    namespace st {
+        template<std::size_t N, class... args>
+        using static_signal = basic_static_signal<single_threaded, N, args...>;
+    }
+}
+
+#endif //SIGSLOT_STATIC_SIGNAL_H
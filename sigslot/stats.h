@@ -0,0 +1,375 @@
+//
+// Created by dwd on 16/10/2026.
+//
+// Emission statistics, recorded by signals that have been instrumented, as in
+// signal.instrument("name"). Each records how often it's emitted, how long its slots take,
+// and how long emitters waited for its lock; sigslot::instrumentation::snapshot() gathers
+// them all up. Signals that aren't instrumented pay only for a null check on each emit.
+// Define SIGSLOT_NO_INSTRUMENTATION to compile all of it out.
+//
+
+#ifndef SIGSLOT_STATS_H
+#define SIGSLOT_STATS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sigslot {
+    namespace internal {
+        class _recording_histogram;
+    }
+
+    // A histogram of durations in nanoseconds, in the style of HdrHistogram: each power of two
+    // is split into eight linear buckets, so any value is recorded to within 12.5%, whatever
+    // its magnitude. Anything over 2^40ns (about 18 minutes) is recorded as that.
+    class latency_histogram
+    {
+    public:
+        static constexpr unsigned sub_bits = 3;
+        static constexpr unsigned max_bits = 40;
+        // The last bucket is for 2^40 itself, and anything over.
+        static constexpr std::size_t buckets = ((max_bits - sub_bits + 1) << sub_bits) + 1;
+
+        void record(std::uint64_t ns)
+        {
+            ++m_counts[bucket(ns)];
+            ++m_count;
+            m_total += ns;
+            m_max = std::max(m_max, ns);
+        }
+
+        void merge(latency_histogram const & other)
+        {
+            for (std::size_t i = 0; i != buckets; ++i) m_counts[i] += other.m_counts[i];
+            m_count += other.m_count;
+            m_total += other.m_total;
+            m_max = std::max(m_max, other.m_max);
+        }
+
+        [[nodiscard]] std::uint64_t count() const { return m_count; }
+        [[nodiscard]] std::uint64_t total() const { return m_total; }
+        [[nodiscard]] std::uint64_t max() const { return m_max; }
+
+        [[nodiscard]] std::uint64_t mean() const
+        {
+            return m_count ? m_total / m_count : 0;
+        }
+
+        // The smallest value that at least fraction p (from 0 to 1) of those recorded are no
+        // greater than, give or take the bucket's width.
+        [[nodiscard]] std::uint64_t percentile(double p) const
+        {
+            if (!m_count) return 0;
+            auto rank = static_cast<std::uint64_t>(p * static_cast<double>(m_count));
+            rank = std::clamp<std::uint64_t>(rank, 1, m_count);
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i != buckets; ++i) {
+                seen += m_counts[i];
+                if (seen >= rank) return std::min(highest(i), m_max);
+            }
+            return m_max;
+        }
+
+        static std::size_t bucket(std::uint64_t ns)
+        {
+            ns = std::min(ns, std::uint64_t{1} << max_bits);
+            if (ns < (1u << sub_bits)) return static_cast<std::size_t>(ns);
+            unsigned magnitude = std::bit_width(ns) - 1;
+            auto sub = (ns >> (magnitude - sub_bits)) & ((1u << sub_bits) - 1);
+            return ((magnitude - sub_bits + 1) << sub_bits) + sub;
+        }
+
+        // The greatest value recorded in bucket b.
+        static std::uint64_t highest(std::size_t b)
+        {
+            if (b < (1u << sub_bits)) return b;
+            auto magnitude = (b >> sub_bits) - 1 + sub_bits;
+            auto sub = b & ((1u << sub_bits) - 1);
+            return (((std::uint64_t{1} << sub_bits) + sub + 1) << (magnitude - sub_bits)) - 1;
+        }
+
+    private:
+        friend class internal::_recording_histogram;
+
+        std::array<std::uint64_t, buckets> m_counts{};
+        std::uint64_t m_count = 0;
+        std::uint64_t m_total = 0;
+        std::uint64_t m_max = 0;
+    };
+
+    // The statistics for one slot, as of a snapshot.
+    struct slot_statistics {
+        std::uint64_t id;           // Unique to the connection, and in the order they were made.
+        void const * dest;          // The has_slots the slot belongs to, if any.
+        latency_histogram latency;  // How long each call took.
+    };
+
+    // The statistics for one signal, as of a snapshot.
+    struct signal_statistics {
+        std::string name;
+        std::uint64_t emits = 0;
+        std::uint64_t slot_calls = 0;
+        std::uint64_t one_shot_expiries = 0;
+        std::uint64_t slow_calls = 0;       // Calls over the latency budget.
+        latency_histogram latency;          // Every slot call, from every slot.
+        latency_histogram lock_wait;        // Each emission's wait for the signal's lock.
+        std::vector<slot_statistics> slots; // Those still connected, in the order they were made.
+    };
+
+    // What the slow slot handler is told.
+    struct slow_slot {
+        std::string_view signal;
+        void const * dest;
+        std::uint64_t id;
+        std::chrono::nanoseconds elapsed;
+    };
+
+    namespace internal {
+        // A histogram that can be recorded into by emitting threads while it's being read
+        // by others. Only one thread records at a time, since a signal's emissions are
+        // serialised by its lock, so relaxed atomics suffice.
+        class _recording_histogram
+        {
+        public:
+            void record(std::uint64_t ns)
+            {
+                bump(m_counts[latency_histogram::bucket(ns)]);
+                bump(m_count);
+                m_total.store(m_total.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+                if (ns > m_max.load(std::memory_order_relaxed)) m_max.store(ns, std::memory_order_relaxed);
+            }
+
+            [[nodiscard]] latency_histogram snapshot() const
+            {
+                latency_histogram h;
+                for (std::size_t i = 0; i != latency_histogram::buckets; ++i) {
+                    h.m_counts[i] = m_counts[i].load(std::memory_order_relaxed);
+                }
+                h.m_count = m_count.load(std::memory_order_relaxed);
+                h.m_total = m_total.load(std::memory_order_relaxed);
+                h.m_max = m_max.load(std::memory_order_relaxed);
+                return h;
+            }
+
+        private:
+            static void bump(std::atomic<std::uint64_t> & a)
+            {
+                a.store(a.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            std::array<std::atomic<std::uint64_t>, latency_histogram::buckets> m_counts{};
+            std::atomic<std::uint64_t> m_count{0};
+            std::atomic<std::uint64_t> m_total{0};
+            std::atomic<std::uint64_t> m_max{0};
+        };
+
+        struct _slot_stats {
+            const std::uint64_t id;
+            void const * const dest;
+            std::atomic<bool> connected{true};
+            _recording_histogram latency;
+
+            _slot_stats(std::uint64_t i, void const * d) : id(i), dest(d) {}
+        };
+
+        class _signal_stats;
+    }
+
+    // Where instrumented signals register themselves, so their statistics can be gathered,
+    // and where the latency budget for slots is set.
+    class instrumentation
+    {
+    public:
+        using slow_slot_handler = std::function<void(slow_slot const &)>;
+
+        // Statistics for every instrumented signal, in the order they were instrumented.
+        static std::vector<signal_statistics> snapshot();
+
+        // Calls handler, on the emitting thread, for each slot call taking longer than
+        // budget. A budget of zero (the default) turns this off.
+        static void on_slow_slot(std::chrono::nanoseconds budget, slow_slot_handler handler)
+        {
+            auto & r = registry();
+            std::scoped_lock lock(r.mutex);
+            r.handler = std::make_shared<slow_slot_handler const>(std::move(handler));
+            r.budget.store(handler_budget(budget), std::memory_order_relaxed);
+        }
+
+    private:
+        friend class internal::_signal_stats;
+
+        struct state {
+            std::mutex mutex;
+            std::vector<internal::_signal_stats *> signals;
+            std::shared_ptr<slow_slot_handler const> handler;
+            std::atomic<std::uint64_t> budget{0};
+        };
+
+        static std::uint64_t handler_budget(std::chrono::nanoseconds budget)
+        {
+            return budget.count() > 0 ? static_cast<std::uint64_t>(budget.count()) : 0;
+        }
+
+        static state & registry()
+        {
+            static state r;
+            return r;
+        }
+    };
+
+    namespace internal {
+        // The statistics an instrumented signal records. Created when the signal is first
+        // instrumented, and kept with its state until the signal is destroyed. Counters are
+        // only ever written with the signal's lock held.
+        class _signal_stats
+        {
+        public:
+            using clock = std::chrono::steady_clock;
+
+            explicit _signal_stats(std::string name) : m_name(std::move(name))
+            {
+                auto & r = instrumentation::registry();
+                std::scoped_lock lock(r.mutex);
+                r.signals.push_back(this);
+            }
+
+            _signal_stats(_signal_stats const &) = delete;
+
+            ~_signal_stats()
+            {
+                auto & r = instrumentation::registry();
+                std::scoped_lock lock(r.mutex);
+                std::erase(r.signals, this);
+            }
+
+            void rename(std::string name)
+            {
+                std::scoped_lock lock(m_mutex);
+                m_name = std::move(name);
+            }
+
+            [[nodiscard]] std::string name() const
+            {
+                std::scoped_lock lock(m_mutex);
+                return m_name;
+            }
+
+            _slot_stats * add_slot(void const * dest)
+            {
+                std::scoped_lock lock(m_mutex);
+                return m_slots.emplace_back(std::make_unique<_slot_stats>(m_next_id++, dest)).get();
+            }
+
+            // A slot's statistics stay until the next sweep, as an emission may be timing it.
+            static void remove_slot(_slot_stats * slot)
+            {
+                if (slot) slot->connected.store(false, std::memory_order_relaxed);
+            }
+
+            void sweep()
+            {
+                std::scoped_lock lock(m_mutex);
+                std::erase_if(m_slots, [](auto const & slot) { return !slot->connected.load(std::memory_order_relaxed); });
+            }
+
+            void emitted(std::uint64_t count = 1)
+            {
+                m_emits.store(m_emits.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+            }
+
+            void expired()
+            {
+                bump(m_expiries);
+            }
+
+            void waited(clock::duration wait)
+            {
+                m_lock_wait.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count()));
+            }
+
+            void called(_slot_stats * slot, clock::duration elapsed)
+            {
+                auto ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                bump(m_calls);
+                m_latency.record(ns);
+                if (slot) slot->latency.record(ns);
+                auto & r = instrumentation::registry();
+                auto budget = r.budget.load(std::memory_order_relaxed);
+                if (budget && ns > budget) [[unlikely]] {
+                    bump(m_slow);
+                    std::shared_ptr<instrumentation::slow_slot_handler const> handler;
+                    std::string name;
+                    {
+                        std::scoped_lock lock(r.mutex);
+                        handler = r.handler;
+                    }
+                    {
+                        std::scoped_lock lock(m_mutex);
+                        name = m_name;
+                    }
+                    if (handler && *handler) {
+                        (*handler)(slow_slot{name, slot ? slot->dest : nullptr, slot ? slot->id : 0, std::chrono::nanoseconds(ns)});
+                    }
+                }
+            }
+
+            [[nodiscard]] signal_statistics snapshot() const
+            {
+                signal_statistics s;
+                std::scoped_lock lock(m_mutex);
+                s.name = m_name;
+                s.emits = m_emits.load(std::memory_order_relaxed);
+                s.slot_calls = m_calls.load(std::memory_order_relaxed);
+                s.one_shot_expiries = m_expiries.load(std::memory_order_relaxed);
+                s.slow_calls = m_slow.load(std::memory_order_relaxed);
+                s.latency = m_latency.snapshot();
+                s.lock_wait = m_lock_wait.snapshot();
+                for (auto const & slot : m_slots) {
+                    if (!slot->connected.load(std::memory_order_relaxed)) continue;
+                    s.slots.push_back(slot_statistics{slot->id, slot->dest, slot->latency.snapshot()});
+                }
+                return s;
+            }
+
+        private:
+            static void bump(std::atomic<std::uint64_t> & a)
+            {
+                a.store(a.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            mutable std::mutex m_mutex;
+            std::string m_name;
+            std::vector<std::unique_ptr<_slot_stats>> m_slots;
+            std::uint64_t m_next_id = 0;
+            std::atomic<std::uint64_t> m_emits{0};
+            std::atomic<std::uint64_t> m_calls{0};
+            std::atomic<std::uint64_t> m_expiries{0};
+            std::atomic<std::uint64_t> m_slow{0};
+            _recording_histogram m_latency;
+            _recording_histogram m_lock_wait;
+        };
+    }
+
+    inline std::vector<signal_statistics> instrumentation::snapshot()
+    {
+        auto & r = registry();
+        std::scoped_lock lock(r.mutex);
+        std::vector<signal_statistics> all;
+        all.reserve(r.signals.size());
+        for (auto s : r.signals) all.push_back(s->snapshot());
+        return all;
+    }
+}
+
+#endif //SIGSLOT_STATS_H
@@ -0,0 +1,262 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#ifndef SIGSLOT_STREAM_H
+#define SIGSLOT_STREAM_H
+
+#include <sigslot/sigslot.h>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace sigslot {
+    namespace internal {
+        // What a stream buffers for each emission: the single argument, or a tuple of them,
+        // either way by value.
+        template<class... args>
+        struct _stream_value {
+            using type = std::tuple<std::decay_t<args>...>;
+        };
+
+        template<class T>
+        struct _stream_value<T> {
+            using type = std::decay_t<T>;
+        };
+    }
+
+    // A buffered subscription to a signal, as returned by signal.stream(capacity): every
+    // emission is copied into a ring buffer, for a coroutine to take at its own pace, so
+    // nothing is missed while it's busy elsewhere - unlike co_await on the signal itself,
+    // which only sees emissions while it's suspended there.
+    //
+    //     auto events = signal.stream(64);
+    //     while (auto ev = co_await events.next()) { ... }
+    //
+    // or, to handle everything buffered each time the coroutine is resumed:
+    //
+    //     while (co_await events.ready()) events.drain([](auto & ev) { ... });
+    //
+    // What happens once the buffer's full is up to its stream_overflow policy. The stream
+    // stays subscribed until it's closed or destroyed; a single coroutine at a time should
+    // consume it, though any thread may emit.
+    template<class mt_policy, class... args>
+    class basic_signal_stream : public basic_has_slots<mt_policy>
+    {
+    public:
+        using value_type = typename internal::_stream_value<args...>::type;
+
+        basic_signal_stream(basic_signal<mt_policy, args...> & signal, std::size_t capacity, stream_overflow policy)
+                : m_ring(capacity ? capacity : 1), m_policy(policy)
+        {
+            signal.connect(this, [this](auto &&... a) { push(value_type(std::forward<decltype(a)>(a)...)); });
+        }
+
+        basic_signal_stream(basic_signal_stream const &) = delete;
+
+        ~basic_signal_stream()
+        {
+            // Stop receiving before the buffer goes.
+            this->disconnect_all();
+        }
+
+        [[nodiscard]] std::size_t capacity() const
+        {
+            return m_ring.size();
+        }
+
+        // Emissions buffered, including any held beyond capacity by stream_overflow::grow.
+        [[nodiscard]] std::size_t size()
+        {
+            std::scoped_lock lock(m_mutex);
+            return m_count + m_overflow.size();
+        }
+
+        // Emissions lost to a full buffer, under drop_oldest or drop_newest.
+        [[nodiscard]] std::uint64_t dropped()
+        {
+            std::scoped_lock lock(m_mutex);
+            return m_dropped;
+        }
+
+        // Emissions that arrived to a full buffer under stream_overflow::grow, and had to be
+        // held beyond capacity. A producer can treat this rising as a sign to slow down.
+        [[nodiscard]] std::uint64_t overflowed()
+        {
+            std::scoped_lock lock(m_mutex);
+            return m_overflowed;
+        }
+
+        // Unsubscribes. Whatever's already buffered can still be taken; after that, next()
+        // gives nothing and ready() false, rather than waiting.
+        void close()
+        {
+            this->disconnect_all();
+            std::coroutine_handle<> awaiting;
+            {
+                std::scoped_lock lock(m_mutex);
+                m_closed = true;
+                awaiting = std::exchange(m_awaiting, nullptr);
+            }
+            if (awaiting) ::sigslot::resume_switch(awaiting);
+        }
+
+        // Takes the oldest buffered emission, if there is one, without waiting.
+        std::optional<value_type> try_next()
+        {
+            std::scoped_lock lock(m_mutex);
+            return pop();
+        }
+
+        // Calls fn with each emission buffered when it's called, oldest first, and returns
+        // how many there were. Emissions arriving meanwhile are left for next time.
+        template<typename Fn>
+        std::size_t drain(Fn && fn)
+        {
+            std::size_t n;
+            {
+                std::scoped_lock lock(m_mutex);
+                n = m_count + m_overflow.size();
+            }
+            for (std::size_t i = 0; i != n; ++i) {
+                auto v = try_next();
+                if (!v) return i;
+                fn(*v);
+            }
+            return n;
+        }
+
+        // Waits until something's buffered, or the stream's closed.
+        class waiter {
+        public:
+            explicit waiter(basic_signal_stream & stream) : m_stream(stream) {}
+
+            bool await_ready()
+            {
+                std::scoped_lock lock(m_stream.m_mutex);
+                return m_stream.m_count || m_stream.m_closed;
+            }
+
+            // Checks again under the lock, so an emission can't slip in between.
+            bool await_suspend(std::coroutine_handle<> h)
+            {
+                std::scoped_lock lock(m_stream.m_mutex);
+                if (m_stream.m_count || m_stream.m_closed) return false;
+                m_stream.m_awaiting = m_suspended = h;
+                return true;
+            }
+
+            // Stops waiting, unless an emission or close() has already resumed the coroutine.
+            // Returns true if it stopped.
+            bool cancel()
+            {
+                std::scoped_lock lock(m_stream.m_mutex);
+                if (!m_suspended || m_stream.m_awaiting != m_suspended) return false;
+                m_stream.m_awaiting = nullptr;
+                return true;
+            }
+
+        protected:
+            basic_signal_stream & m_stream;
+            std::coroutine_handle<> m_suspended;
+        };
+
+        // Resolves to the oldest buffered emission, or nothing once the stream's closed and
+        // empty.
+        class next_awaiter : public waiter {
+        public:
+            using waiter::waiter;
+
+            std::optional<value_type> await_resume()
+            {
+                return this->m_stream.try_next();
+            }
+        };
+
+        // Resolves to true once there's something to drain(), or false if the stream's closed
+        // and empty.
+        class ready_awaiter : public waiter {
+        public:
+            using waiter::waiter;
+
+            bool await_resume()
+            {
+                return this->m_stream.size() != 0;
+            }
+        };
+
+        [[nodiscard]] next_awaiter next()
+        {
+            return next_awaiter(*this);
+        }
+
+        [[nodiscard]] ready_awaiter ready()
+        {
+            return ready_awaiter(*this);
+        }
+
+    private:
+        void push(value_type && v)
+        {
+            std::unique_lock lock(m_mutex);
+            if (m_count == m_ring.size() || !m_overflow.empty()) {
+                switch (m_policy) {
+                    case stream_overflow::drop_newest:
+                        ++m_dropped;
+                        return;
+                    case stream_overflow::drop_oldest:
+                        ++m_dropped;
+                        m_ring[m_head] = std::move(v);
+                        m_head = (m_head + 1) % m_ring.size();
+                        return;
+                    case stream_overflow::grow:
+                        ++m_overflowed;
+                        m_overflow.push_back(std::move(v));
+                        return;
+                }
+            }
+            m_ring[(m_head + m_count) % m_ring.size()] = std::move(v);
+            ++m_count;
+            // Resumed outside the lock, since the coroutine will want it.
+            auto awaiting = std::exchange(m_awaiting, nullptr);
+            lock.unlock();
+            if (awaiting) ::sigslot::resume_switch(awaiting);
+        }
+
+        // Must be called with m_mutex held.
+        std::optional<value_type> pop()
+        {
+            if (!m_count) return std::nullopt;
+            std::optional<value_type> v = std::move(m_ring[m_head]);
+            m_ring[m_head].reset();
+            m_head = (m_head + 1) % m_ring.size();
+            --m_count;
+            // Anything held beyond capacity moves up, in order.
+            if (!m_overflow.empty()) {
+                m_ring[(m_head + m_count) % m_ring.size()] = std::move(m_overflow.front());
+                m_overflow.pop_front();
+                ++m_count;
+            }
+            return v;
+        }
+
+        [[no_unique_address]] mt_policy m_mutex;
+        std::vector<std::optional<value_type>> m_ring;
+        std::size_t m_head = 0;
+        std::size_t m_count = 0;
+        std::deque<value_type> m_overflow;
+        const stream_overflow m_policy;
+        bool m_closed = false;
+        std::uint64_t m_dropped = 0;
+        std::uint64_t m_overflowed = 0;
+        std::coroutine_handle<> m_awaiting;
+    };
+}
+
+#endif //SIGSLOT_STREAM_H
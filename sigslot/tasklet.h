@@ -6,6 +6,7 @@
 #define SIGSLOT_TASKLET_H
 
 #include <sigslot/sigslot.h>
+#include <atomic>
 #include <coroutine>
 #include <string>
 #include <stdexcept>
@@ -56,6 +57,7 @@ namespace sigslot {
             ~tasklet() {
                 if (coro) {
                     ::sigslot::deregister_switch(coro);
+                    if (!coro.promise().name.empty()) internal::_trace::forget(coro.address());
                     coro.destroy();
                 }
             }
@@ -72,8 +74,10 @@ namespace sigslot {
             }
             void await_suspend(std::coroutine_handle<> h) const {
                 // The awaiting coroutine is already suspended.
-                if (coro.promise().awaiting) throw std::logic_error("Already an awaiter for this task");
-                coro.promise().awaiting = h;
+                std::coroutine_handle<> none;
+                if (!std::atomic_ref(coro.promise().awaiting).compare_exchange_strong(none, h)) {
+                    throw std::logic_error("Already an awaiter for this task");
+                }
             }
             bool await_ready() const {
                 if (!coro.promise().started) {
@@ -85,8 +89,43 @@ namespace sigslot {
             auto await_resume() const {
                 return get();
             }
-            auto const & operator co_await() const {
-                return *this;
+            // Some compilers (GCC 12, at least) copy an awaiter returned by reference from
+            // operator co_await, which would share (and double-destroy) the coroutine.
+            struct awaiter {
+                tasklet const & task;
+                std::coroutine_handle<> suspended = nullptr;
+
+                // An awaiting coroutine destroyed before this task finishes mustn't be resumed.
+                ~awaiter() {
+                    cancel();
+                }
+                bool await_ready() const {
+                    return task.await_ready();
+                }
+                // Notes h first: once the task has it, it may finish on another thread, and
+                // resume (and destroy) the awaiting coroutine, this awaiter included.
+                void await_suspend(std::coroutine_handle<> h) {
+                    suspended = h;
+                    try {
+                        task.await_suspend(h);
+                    } catch (...) {
+                        suspended = nullptr;
+                        throw;
+                    }
+                }
+                // Stops waiting, unless the task has already finished (and so resumed, or is
+                // resuming, the awaiting coroutine). Returns true if it stopped.
+                bool cancel() {
+                    if (!suspended || !task.coro) return false;
+                    auto expected = suspended;
+                    return std::atomic_ref(task.coro.promise().awaiting).compare_exchange_strong(expected, nullptr);
+                }
+                auto await_resume() const {
+                    return task.await_resume();
+                }
+            };
+            awaiter operator co_await() const {
+                return {*this};
             }
 
 
@@ -100,6 +139,14 @@ namespace sigslot {
                 if (coro.promise().started) throw std::logic_error("Already started");
                 if (coro.promise().finished) throw std::logic_error("Already finished");
                 coro.promise().started = true;
+                if (internal::_trace::on()) [[unlikely]] {
+                    auto & name = coro.promise().name;
+                    std::string traced = name.empty() ? "tasklet" : name;
+                    auto start = internal::_trace::clock::now();
+                    coro.resume();
+                    internal::_trace::complete(internal::_trace_category::tasklet, traced, coro.address(), start);
+                    return;
+                }
                 coro.resume();
             }
 
@@ -116,8 +163,10 @@ namespace sigslot {
                 return coro.promise().exception;
             }
 
+            // Also names the coroutine in traces.
             void set_name(std::string const &s) {
                 coro.promise().set_name(s);
+                internal::_trace::name(coro.address(), s);
             }
 
             auto operator*() const {
@@ -134,6 +183,8 @@ namespace sigslot {
             bool finished = false;
             std::coroutine_handle<> awaiting;
             std::shared_ptr<tracker> track;
+            // This coroutine, whose frame address identifies it in traces.
+            std::coroutine_handle<> self;
 
             promise_type_base() {}
             promise_type_base(promise_type_base const &) = delete;
@@ -147,12 +198,16 @@ namespace sigslot {
 
             auto final_suspend() noexcept {
                 finished = true;
+                if (internal::_trace::on()) [[unlikely]] {
+                    internal::_trace::instant(internal::_trace_category::tasklet, name.empty() ? "finished" : name, self.address());
+                }
                 complete();
                 if (track) {
                     track->terminate();
                     track = nullptr;
                 }
-                if (awaiting) ::sigslot::resume_switch(awaiting);
+                // Taken atomically, as an awaiter on another thread may be cancelling.
+                if (auto a = std::atomic_ref(awaiting).exchange(nullptr)) ::sigslot::resume_switch(a);
                 return std::suspend_always{};
             }
 
@@ -196,7 +251,9 @@ namespace sigslot {
             promise_type(std::shared_ptr<Tracker> const & t, Args&&...) : promise_type_base(t), value() {}
 
             auto get_return_object() {
-                return R{handle_type::from_promise(*this)};
+                auto h = handle_type::from_promise(*this);
+                self = h;
+                return R{h};
             }
 
             auto return_value(T v) {
@@ -225,7 +282,9 @@ namespace sigslot {
             promise_type() {}
 
             auto get_return_object() {
-                return R{handle_type::from_promise(*this)};
+                auto h = handle_type::from_promise(*this);
+                self = h;
+                return R{h};
             }
 
             auto return_void() {
@@ -0,0 +1,325 @@
+//
+// Created by dwd on 16/10/2026.
+//
+// A timeline of signal emissions, slot calls and coroutine resumptions, in Chrome's Trace
+// Event format - load the file written by sigslot::tracing::write() into chrome://tracing or
+// ui.perfetto.dev. Tracing is off until sigslot::tracing::start(); until then, each emission
+// and resumption pays for a single relaxed load. Events go into a lock-free ring buffer per
+// thread, and are only gathered up when written out. Signals are named by instrument(), and
+// tasklets by set_name(). Define SIGSLOT_NO_TRACING to compile all of it out.
+//
+
+#ifndef SIGSLOT_TRACE_H
+#define SIGSLOT_TRACE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sigslot {
+    namespace internal {
+        enum class _trace_category : char { signal, slot, tasklet };
+
+        class _trace
+        {
+        public:
+            // One event, sized to a cache line. Names longer than will fit are truncated.
+            struct event {
+                std::uint64_t start;    // Nanoseconds since tracing started.
+                std::uint64_t duration; // Nanoseconds, for complete events.
+                void const * id;        // The signal, has_slots, or coroutine.
+                char phase;             // 'X' for a complete event, 'i' for an instant one.
+                _trace_category category;
+                char name[38];
+            };
+
+            // Each thread's events, written only by that thread and read only by write().
+            // When it's full, new events are dropped, and counted. Once the thread has exited,
+            // it's dead, and freed as soon as it's empty.
+            struct ring {
+                std::unique_ptr<event[]> events;
+                std::uint64_t mask;
+                std::uint64_t tid;
+                std::atomic<std::uint64_t> head{0};
+                std::atomic<std::uint64_t> tail{0};
+                std::atomic<std::uint64_t> dropped{0};
+                std::atomic<bool> dead{false};
+
+                ring(std::size_t capacity, std::uint64_t t) : events(std::make_unique<event[]>(capacity)), mask(capacity - 1), tid(t) {}
+
+                void push(event const & e)
+                {
+                    auto h = head.load(std::memory_order_relaxed);
+                    if (h - tail.load(std::memory_order_acquire) > mask) {
+                        dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    events[h & mask] = e;
+                    head.store(h + 1, std::memory_order_release);
+                }
+
+                template<typename F>
+                void drain(F && f)
+                {
+                    auto t = tail.load(std::memory_order_relaxed);
+                    auto h = head.load(std::memory_order_acquire);
+                    for (; t != h; ++t) f(events[t & mask]);
+                    tail.store(h, std::memory_order_release);
+                }
+
+                [[nodiscard]] bool empty() const
+                {
+                    return tail.load(std::memory_order_relaxed) == head.load(std::memory_order_acquire);
+                }
+            };
+
+            // Marks the thread's ring dead as the thread exits.
+            struct owner {
+                std::shared_ptr<ring> r;
+
+                ~owner()
+                {
+                    if (r) r->dead.store(true, std::memory_order_release);
+                }
+            };
+
+            struct state {
+                std::mutex mutex;
+                std::vector<std::shared_ptr<ring>> rings;
+                std::uint64_t reaped_dropped = 0;   // Dropped by rings since freed.
+                std::atomic<bool> on{false};
+                std::size_t capacity = 0;
+                std::uint64_t next_tid = 1;
+                std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+                std::mutex names_mutex;
+                std::unordered_map<void const *, std::string> names;
+            };
+
+            static state & tracer()
+            {
+                static state s;
+                return s;
+            }
+
+            [[nodiscard]] static bool on()
+            {
+                return tracer().on.load(std::memory_order_relaxed);
+            }
+
+            using clock = std::chrono::steady_clock;
+
+            static void complete(_trace_category category, std::string_view name, void const * id, clock::time_point start, clock::time_point end = clock::now())
+            {
+                record('X', category, name, id, since_epoch(start), nanos(end - start));
+            }
+
+            static void instant(_trace_category category, std::string_view name, void const * id)
+            {
+                record('i', category, name, id, since_epoch(clock::now()), 0);
+            }
+
+            // Coroutines are named by their frame's address, so they can be found from a
+            // plain std::coroutine_handle<>.
+            static void name(void const * frame, std::string const & n)
+            {
+                auto & s = tracer();
+                std::scoped_lock lock(s.names_mutex);
+                s.names[frame] = n;
+            }
+
+            static void forget(void const * frame)
+            {
+                auto & s = tracer();
+                std::scoped_lock lock(s.names_mutex);
+                s.names.erase(frame);
+            }
+
+            // Frees the rings of threads that have exited, once everything they recorded has
+            // been written. Must be called with tracer().mutex held.
+            static void reap(state & s)
+            {
+                std::erase_if(s.rings, [&s](auto const & r) {
+                    if (!r->dead.load(std::memory_order_acquire) || !r->empty()) return false;
+                    s.reaped_dropped += r->dropped.load(std::memory_order_relaxed);
+                    return true;
+                });
+            }
+
+            static std::string name_of(void const * frame)
+            {
+                auto & s = tracer();
+                std::scoped_lock lock(s.names_mutex);
+                auto it = s.names.find(frame);
+                return it == s.names.end() ? std::string("coroutine") : it->second;
+            }
+
+        private:
+            static std::uint64_t nanos(clock::duration d)
+            {
+                return static_cast<std::uint64_t>(std::max<std::int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()));
+            }
+
+            static std::uint64_t since_epoch(clock::time_point t)
+            {
+                return nanos(t - tracer().epoch);
+            }
+
+            static void record(char phase, _trace_category category, std::string_view name, void const * id, std::uint64_t start, std::uint64_t duration)
+            {
+                auto r = local();
+                if (!r) return;
+                event e{start, duration, id, phase, category, {}};
+                auto n = std::min(name.size(), sizeof(e.name) - 1);
+                std::copy_n(name.data(), n, e.name);
+                e.name[n] = '\0';
+                r->push(e);
+            }
+
+            // Created on the thread's first event.
+            static ring * local()
+            {
+                thread_local owner o;
+                if (!o.r) {
+                    auto & s = tracer();
+                    std::scoped_lock lock(s.mutex);
+                    if (!s.capacity) return nullptr;
+                    reap(s);
+                    o.r = std::make_shared<ring>(s.capacity, s.next_tid++);
+                    s.rings.push_back(o.r);
+                }
+                return o.r.get();
+            }
+        };
+    }
+
+    // Starts and stops tracing, and writes out what's been traced.
+    class tracing
+    {
+    public:
+        // Each thread buffers up to capacity events (rounded up to a power of two, at 64 bytes
+        // each) between writes; capacity only applies to threads that haven't yet traced
+        // anything. A thread's buffer is freed once it has exited and its events are written.
+        static void start(std::size_t capacity = 8192)
+        {
+            auto & s = internal::_trace::tracer();
+            std::scoped_lock lock(s.mutex);
+            std::size_t size = 2;
+            while (size < capacity) size <<= 1;
+            s.capacity = size;
+            s.on.store(true);
+        }
+
+        static void stop()
+        {
+            internal::_trace::tracer().on.store(false);
+        }
+
+        [[nodiscard]] static bool enabled()
+        {
+            return internal::_trace::on();
+        }
+
+        // Events dropped so far, because a thread's buffer was full.
+        [[nodiscard]] static std::uint64_t dropped()
+        {
+            auto & s = internal::_trace::tracer();
+            std::scoped_lock lock(s.mutex);
+            std::uint64_t total = s.reaped_dropped;
+            for (auto const & r : s.rings) total += r->dropped.load(std::memory_order_relaxed);
+            return total;
+        }
+
+        // Writes every event buffered since the last write, as a JSON trace, and empties the
+        // buffers. Tracing carries on, if it's running.
+        static void write(std::ostream & out)
+        {
+            auto & s = internal::_trace::tracer();
+            std::scoped_lock lock(s.mutex);
+            out << R"({"displayTimeUnit":"ns","traceEvents":[)";
+            bool first = true;
+            auto separate = [&out, &first]() {
+                if (!first) out << ',';
+                out << '\n';
+                first = false;
+            };
+            for (auto const & r : s.rings) {
+                separate();
+                out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << r->tid
+                    << R"(,"args":{"name":"thread )" << r->tid << R"("}})";
+                r->drain([&](internal::_trace::event const & e) {
+                    separate();
+                    out << R"({"name":)";
+                    quote(out, e.name);
+                    out << R"(,"cat":")" << category(e.category) << R"(","ph":")" << e.phase << '"'
+                        << R"(,"ts":)" << micros(e.start);
+                    if (e.phase == 'X') out << R"(,"dur":)" << micros(e.duration);
+                    if (e.phase == 'i') out << R"(,"s":"t")";
+                    char id[2 * sizeof(void *) + 3];
+                    std::snprintf(id, sizeof(id), "%p", e.id);
+                    out << R"(,"pid":1,"tid":)" << r->tid << R"(,"args":{"id":")" << id << R"("}})";
+                });
+            }
+            out << "\n]}\n";
+            internal::_trace::reap(s);
+        }
+
+        // As above, to the file at path; returns false if it can't be written.
+        static bool write(std::string const & path)
+        {
+            std::ofstream out(path, std::ios::trunc);
+            if (!out) return false;
+            write(out);
+            return static_cast<bool>(out.flush());
+        }
+
+    private:
+        static char const * category(internal::_trace_category c)
+        {
+            switch (c) {
+                case internal::_trace_category::signal: return "signal";
+                case internal::_trace_category::slot: return "slot";
+                case internal::_trace_category::tasklet: return "tasklet";
+            }
+            return "";
+        }
+
+        // Trace timestamps are in microseconds.
+        static std::string micros(std::uint64_t ns)
+        {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%llu.%03llu",
+                          static_cast<unsigned long long>(ns / 1000), static_cast<unsigned long long>(ns % 1000));
+            return buf;
+        }
+
+        static void quote(std::ostream & out, std::string_view s)
+        {
+            out << '"';
+            for (char c : s) {
+                if (c == '"' || c == '\\') {
+                    out << '\\' << c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                    out << buf;
+                } else {
+                    out << c;
+                }
+            }
+            out << '"';
+        }
+    };
+}
+
+#endif //SIGSLOT_TRACE_H
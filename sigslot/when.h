@@ -0,0 +1,383 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#ifndef SIGSLOT_WHEN_H
+#define SIGSLOT_WHEN_H
+
+#include <sigslot/sigslot.h>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace sigslot {
+    namespace internal {
+        // Whatever co_await on an A would use as its awaiter.
+        template<class A>
+        decltype(auto) _get_awaiter(A & a)
+        {
+            if constexpr (requires { a.operator co_await(); }) {
+                return a.operator co_await();
+            } else {
+                return (a);
+            }
+        }
+
+        template<class A>
+        using _awaiter_t = std::remove_reference_t<decltype(_get_awaiter(std::declval<A &>()))>;
+
+        template<class A>
+        using _await_result_t = decltype(std::declval<_awaiter_t<A> &>().await_resume());
+
+        // What a combinator keeps of each result: void becomes std::monostate, and references
+        // - to a signal's arguments, say - are copied, since the parent may only resume long
+        // after the emission has finished.
+        template<class R>
+        struct _when_value {
+            using type = std::decay_t<R>;
+        };
+
+        template<>
+        struct _when_value<void> {
+            using type = std::monostate;
+        };
+
+        template<class... Ts>
+        struct _when_value<std::tuple<Ts...>> {
+            using type = std::tuple<std::decay_t<Ts>...>;
+        };
+
+        template<class A>
+        using _when_value_t = typename _when_value<std::remove_cvref_t<_await_result_t<A>>>::type;
+
+        // An awaiter that can stop waiting: cancel() returns true if it did, and the coroutine
+        // will then never be resumed by whatever it was waiting for, or false if that's
+        // already happening.
+        template<class A>
+        concept _cancellable = requires(_awaiter_t<A> & a) {
+            { a.cancel() } -> std::convertible_to<bool>;
+        };
+
+        // Constructs the result of f in place, through guaranteed copy elision.
+        template<class F>
+        struct _elide {
+            F f;
+
+            operator std::invoke_result_t<F &>()
+            {
+                return f();
+            }
+        };
+
+        // The awaiter for a child: either one of its own, made by its operator co_await, or
+        // the child itself.
+        template<class A>
+        class _when_awaiter {
+        public:
+            using type = _awaiter_t<A>;
+
+            type & make(A & a)
+            {
+                if constexpr (by_reference) {
+                    m_awaiter = &_get_awaiter(a);
+                    return *m_awaiter;
+                } else {
+                    return m_awaiter.emplace(_elide{[&a]() { return _get_awaiter(a); }});
+                }
+            }
+
+            type * get()
+            {
+                if constexpr (by_reference) {
+                    return m_awaiter;
+                } else {
+                    return m_awaiter ? &*m_awaiter : nullptr;
+                }
+            }
+
+        private:
+            static constexpr bool by_reference = std::is_reference_v<decltype(_get_awaiter(std::declval<A &>()))>;
+            std::conditional_t<by_reference, type *, std::optional<type>> m_awaiter{};
+        };
+
+        // The coroutine that awaits each child of a combinator on its behalf. It tells the
+        // combinator once it's finished, and stays suspended until the combinator destroys it.
+        template<class Owner>
+        struct _when_child {
+            struct promise_type {
+                Owner * owner = nullptr;
+                std::size_t index = 0;
+                std::exception_ptr eptr;
+
+                _when_child get_return_object()
+                {
+                    return {std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::suspend_always initial_suspend() noexcept
+                {
+                    return {};
+                }
+
+                struct final_awaiter {
+                    bool await_ready() noexcept
+                    {
+                        return false;
+                    }
+
+                    // The frame may be destroyed as soon as the owner knows, so nothing after.
+                    void await_suspend(std::coroutine_handle<promise_type> h) noexcept
+                    {
+                        auto & p = h.promise();
+                        p.owner->finished(p.index);
+                    }
+
+                    void await_resume() noexcept {}
+                };
+
+                final_awaiter final_suspend() noexcept
+                {
+                    return {};
+                }
+
+                void return_void() {}
+
+                void unhandled_exception()
+                {
+                    eptr = std::current_exception();
+                }
+            };
+
+            std::coroutine_handle<promise_type> coro;
+        };
+
+        // What when_all and when_any share: the children (held by reference if they were given
+        // as lvalues, or moved in otherwise), their awaiters and results, and a coroutine
+        // awaiting each. Each child, once done with - finished, cancelled, or never started -
+        // counts down m_pending, as does the parent once it has started them all, and the
+        // last resumes the parent. So nothing touches this once the parent's been resumed,
+        // and it can be destroyed along with the children's coroutines.
+        template<class Derived, class... Children>
+        class _when_base {
+        public:
+            static constexpr std::size_t size = sizeof...(Children);
+
+            explicit _when_base(Children &&... children) : m_children(std::forward<Children>(children)...) {}
+            _when_base(_when_base const &) = delete;
+
+            // If the parent's been destroyed while waiting, this also stops waiting for the
+            // children still running.
+            ~_when_base()
+            {
+                for (auto coro : m_coros) {
+                    if (!coro) continue;
+                    ::sigslot::deregister_switch(coro);
+                    coro.destroy();
+                }
+            }
+
+            bool await_ready() const noexcept
+            {
+                return size == 0;
+            }
+
+        protected:
+            using child_type = _when_child<Derived>;
+            using child_handle = std::coroutine_handle<typename child_type::promise_type>;
+
+            template<std::size_t I>
+            static child_type await_child(Derived & self)
+            {
+                using A = std::remove_reference_t<std::tuple_element_t<I, std::tuple<Children...>>>;
+                auto & awaiter = std::get<I>(self.m_awaiters).make(std::get<I>(self.m_children));
+                if constexpr (std::is_void_v<_await_result_t<A>>) {
+                    co_await awaiter;
+                    std::get<I>(self.m_results).emplace();
+                } else {
+                    std::get<I>(self.m_results).emplace(co_await awaiter);
+                }
+            }
+
+            template<std::size_t I>
+            void start_child()
+            {
+                auto coro = await_child<I>(static_cast<Derived &>(*this)).coro;
+                coro.promise().owner = static_cast<Derived *>(this);
+                coro.promise().index = I;
+                m_coros[I] = coro;
+                ::sigslot::register_switch(coro);
+                coro.resume();
+            }
+
+            // Returns true if that was the last, and the parent's to carry on.
+            bool done_with(std::size_t n = 1)
+            {
+                return m_pending.fetch_sub(n, std::memory_order_acq_rel) == n;
+            }
+
+            void arrive()
+            {
+                if (done_with()) ::sigslot::resume_switch(m_parent);
+            }
+
+            void rethrow(std::size_t i) const
+            {
+                if (auto eptr = m_coros[i].promise().eptr) std::rethrow_exception(eptr);
+            }
+
+            std::tuple<Children...> m_children;
+            std::tuple<_when_awaiter<std::remove_reference_t<Children>>...> m_awaiters;
+            std::tuple<std::optional<_when_value_t<std::remove_reference_t<Children>>>...> m_results;
+            std::array<child_handle, size> m_coros{};
+            std::coroutine_handle<> m_parent;
+            std::atomic<std::size_t> m_pending{size + 1};
+        };
+    }
+
+    // Awaits every child at once, resolving to a std::tuple of their results once the last has
+    // finished. If any threw, the first (by position) is rethrown instead.
+    template<class... Children>
+    class when_all_awaiter : public internal::_when_base<when_all_awaiter<Children...>, Children...> {
+        using base = internal::_when_base<when_all_awaiter<Children...>, Children...>;
+        friend base;
+        friend typename base::child_type::promise_type::final_awaiter;
+
+    public:
+        using base::base;
+
+        // Starts each child in turn; the parent only suspends if some are still running once
+        // they've all been started.
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            this->m_parent = h;
+            [this]<std::size_t... I>(std::index_sequence<I...>) {
+                (this->template start_child<I>(), ...);
+            }(std::index_sequence_for<Children...>{});
+            return !this->done_with();
+        }
+
+        auto await_resume()
+        {
+            for (std::size_t i = 0; i != base::size; ++i) this->rethrow(i);
+            return std::apply([](auto &... r) {
+                return std::make_tuple(std::move(*r)...);
+            }, this->m_results);
+        }
+
+    private:
+        void finished(std::size_t)
+        {
+            this->arrive();
+        }
+    };
+
+    // Awaits every child at once, resolving to the index of the first to finish along with its
+    // result, as the alternative of the same index. The rest are cancelled - signals and
+    // streams stop being awaited, and tasklets lose their awaiter, or are destroyed if they
+    // were handed over as temporaries - and the parent isn't resumed until each has either
+    // stopped waiting or finished, so none is left running. If the first to finish threw,
+    // that's rethrown instead.
+    template<class... Children>
+    class when_any_awaiter : public internal::_when_base<when_any_awaiter<Children...>, Children...> {
+        using base = internal::_when_base<when_any_awaiter<Children...>, Children...>;
+        friend base;
+        friend typename base::child_type::promise_type::final_awaiter;
+
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+    public:
+        using result_type = std::pair<std::size_t, std::variant<internal::_when_value_t<std::remove_reference_t<Children>>...>>;
+
+        using base::base;
+
+        // Children after one that finishes straight away aren't started at all. The losers
+        // are cancelled by whichever of this and the winner gets to m_ready second, so it's
+        // only done once every child has been started.
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            this->m_parent = h;
+            [this]<std::size_t... I>(std::index_sequence<I...>) {
+                ((m_winner.load(std::memory_order_acquire) == none ? this->template start_child<I>() : void(this->done_with())), ...);
+            }(std::index_sequence_for<Children...>{});
+            if (m_ready.exchange(true, std::memory_order_acq_rel)) cancel_losers();
+            return !this->done_with();
+        }
+
+        result_type await_resume()
+        {
+            auto winner = m_winner.load(std::memory_order_acquire);
+            this->rethrow(winner);
+            return result(winner, std::index_sequence_for<Children...>{});
+        }
+
+    private:
+        void finished(std::size_t i)
+        {
+            auto expected = none;
+            if (m_winner.compare_exchange_strong(expected, i, std::memory_order_acq_rel)) {
+                if (m_ready.exchange(true, std::memory_order_acq_rel)) cancel_losers();
+            }
+            this->arrive();
+        }
+
+        // Called holding a count of its own, so the parent can't be resumed meanwhile.
+        void cancel_losers()
+        {
+            auto winner = m_winner.load(std::memory_order_acquire);
+            [this, winner]<std::size_t... I>(std::index_sequence<I...>) {
+                (cancel<I>(winner), ...);
+            }(std::index_sequence_for<Children...>{});
+        }
+
+        // A child that's cancelled will never be resumed, so it's done with here; one that
+        // can't be is already finishing, and will say so itself.
+        template<std::size_t I>
+        void cancel(std::size_t winner)
+        {
+            if (I == winner || !this->m_coros[I]) return;
+            auto awaiter = std::get<I>(this->m_awaiters).get();
+            if (awaiter && awaiter->cancel()) this->done_with();
+        }
+
+        template<std::size_t... I>
+        result_type result(std::size_t winner, std::index_sequence<I...>)
+        {
+            std::optional<result_type> r;
+            ((winner == I ? void(r.emplace(I, typename result_type::second_type(std::in_place_index<I>, std::move(*std::get<I>(this->m_results))))) : void()), ...);
+            return std::move(*r);
+        }
+
+        std::atomic<std::size_t> m_winner{none};
+        std::atomic<bool> m_ready{false};
+    };
+
+    // co_await when_all(a, b, ...) awaits any mix of tasklets, signals and other awaitables
+    // concurrently. Lvalues are awaited in place, so must outlive the co_await; temporaries are
+    // moved in.
+    template<class... Children>
+    when_all_awaiter<Children...> when_all(Children &&... children)
+    {
+        return when_all_awaiter<Children...>(std::forward<Children>(children)...);
+    }
+
+    // co_await when_any(a, b, ...) is the same, but resumes with the first to finish. Every
+    // child has to be cancellable: tasklets, signals, static_signals and streams all are.
+    template<class... Children>
+    requires (sizeof...(Children) > 0) && (internal::_cancellable<std::remove_reference_t<Children>> && ...)
+    when_any_awaiter<Children...> when_any(Children &&... children)
+    {
+        return when_any_awaiter<Children...>(std::forward<Children>(children)...);
+    }
+}
+
+#endif //SIGSLOT_WHEN_H
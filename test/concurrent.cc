@@ -0,0 +1,241 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <sigslot/concurrent.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    class Counter : public sigslot::has_slots {
+    public:
+        std::atomic<int> count = 0;
+        void slot(int i) {
+            count += i;
+        }
+    };
+}
+
+TEST(Concurrent, Simple) {
+    Counter counter;
+    sigslot::concurrent_signal<int> signal;
+    signal.connect(&counter, &Counter::slot);
+    signal(2);
+    signal.connect<&Counter::slot>(&counter);
+    signal(3);
+    EXPECT_EQ(counter.count, 8);
+    signal.disconnect(&counter);
+    signal(100);
+    EXPECT_EQ(counter.count, 8);
+}
+
+TEST(Concurrent, OneShot) {
+    Counter counter;
+    sigslot::concurrent_signal<int> signal;
+    signal.connect(&counter, &Counter::slot, true);
+    signal(2);
+    signal(3);
+    EXPECT_EQ(counter.count, 2);
+}
+
+TEST(Concurrent, Lifetime) {
+    sigslot::concurrent_signal<int> signal;
+    {
+        Counter counter;
+        signal.connect(&counter, &Counter::slot);
+        signal(2);
+        EXPECT_EQ(counter.count, 2);
+    }
+    signal(3);
+    {
+        Counter counter;
+        signal.connect(&counter, &Counter::slot);
+        {
+            sigslot::concurrent_signal<int> inner;
+            inner.connect(&counter, &Counter::slot);
+        }
+        signal(3);
+        EXPECT_EQ(counter.count, 3);
+    }
+}
+
+TEST(Concurrent, DisconnectDuringEmit) {
+    Counter counter;
+    auto victim = std::make_unique<Counter>();
+    sigslot::concurrent_signal<int> signal;
+    signal.connect(&counter, [&](int i) {
+        counter.slot(i);
+        victim.reset();
+    });
+    signal.connect(victim.get(), &Counter::slot);
+    signal(1);
+    signal(1);
+    EXPECT_EQ(counter.count, 2);
+}
+
+TEST(Concurrent, DestroyWhileSlotDisconnects) {
+    sigslot::concurrent_signal<int> signal;
+    sigslot::signal<int> other;
+    auto counter = std::make_unique<Counter>();
+    auto handle = other.connect<&Counter::slot>(counter.get());
+    std::atomic<bool> entered = false;
+    std::atomic<bool> destroying = false;
+    // Disconnecting the other connection needs the has_slots' lock, which its destructor
+    // mustn't be holding while it waits for this emission to finish.
+    signal.connect(counter.get(), [&](int) {
+        entered = true;
+        while (!destroying) std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        handle.disconnect();
+    });
+    std::thread emitter([&]() { signal(1); });
+    while (!entered) std::this_thread::yield();
+    std::promise<void> destroyed;
+    auto done = destroyed.get_future();
+    std::thread destroyer([&]() {
+        destroying = true;
+        counter.reset();
+        destroyed.set_value();
+    });
+    if (done.wait_for(std::chrono::seconds(10)) != std::future_status::ready) {
+        std::fprintf(stderr, "has_slots destructor deadlocked with an emission\n");
+        std::abort();
+    }
+    destroyer.join();
+    emitter.join();
+    EXPECT_FALSE(handle.connected());
+}
+
+TEST(Concurrent, DestroyWithinOtherEmission) {
+    sigslot::concurrent_signal<int> signal;
+    sigslot::concurrent_signal<> other;
+    auto counter = std::make_unique<Counter>();
+    std::atomic<bool> entered = false;
+    std::atomic<bool> finished = false;
+    signal.connect(counter.get(), [&](int) {
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    });
+    std::thread emitter([&]() { signal(1); });
+    while (!entered) std::this_thread::yield();
+    // Emitting a different signal is no reason not to wait for this one's emission.
+    auto c = other.connect([&]() {
+        counter.reset();
+        EXPECT_TRUE(finished);
+    });
+    other();
+    EXPECT_FALSE(counter);
+    emitter.join();
+}
+
+TEST(Concurrent, Threads) {
+    Counter counter;
+    sigslot::concurrent_signal<int> signal;
+    signal.connect<&Counter::slot>(&counter);
+    std::atomic<bool> stop = false;
+    std::vector<std::jthread> threads;
+    for (int t = 0; t != 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i != 1000; ++i) signal(1);
+        });
+    }
+    // Churn connections while the emitters run.
+    threads.emplace_back([&]() {
+        for (int i = 0; i != 200; ++i) {
+            Counter transient;
+            signal.connect<&Counter::slot>(&transient);
+            std::this_thread::yield();
+        }
+    });
+    threads.clear();
+    EXPECT_EQ(counter.count, 4000);
+}
+
+TEST(Concurrent, OneShotKeepsOtherConnections) {
+    sigslot::concurrent_signal<int> signal;
+    std::atomic<int> always = 0;
+    {
+        Counter counter;
+        signal.connect(&counter, &Counter::slot, true);
+        signal.connect(&counter, [&always](int i) { always += i; });
+        signal(1);
+        signal(1);
+        EXPECT_EQ(counter.count, 1);
+        EXPECT_EQ(always, 2);
+    }
+    signal(1);
+    EXPECT_EQ(always, 2);
+}
+
+TEST(Concurrent, ThrowingOneShot) {
+    Counter counter;
+    sigslot::concurrent_signal<int> signal;
+    auto conn = signal.connect(&counter, [&counter](int i) {
+        counter.slot(i);
+        throw std::runtime_error("once");
+    }, true);
+    EXPECT_THROW(signal(1), std::runtime_error);
+    EXPECT_FALSE(conn.connected());
+    signal(1);
+    EXPECT_EQ(counter.count, 1);
+}
+
+TEST(Concurrent, Connection) {
+    Counter counter;
+    sigslot::concurrent_signal<int> signal;
+    auto conn = signal.connect(&counter, &Counter::slot);
+    conn.block();
+    signal(1);
+    conn.unblock();
+    signal(2);
+    conn.disconnect();
+    EXPECT_FALSE(conn.connected());
+    signal(4);
+    EXPECT_EQ(counter.count, 2);
+    {
+        auto scoped = signal.connect([&counter](int i) { counter.count += i; });
+        signal(8);
+    }
+    signal(16);
+    EXPECT_EQ(counter.count, 10);
+}
+
+TEST(Concurrent, Priority) {
+    Counter counter;
+    std::string order;
+    sigslot::concurrent_signal<int> signal;
+    signal.connect(&counter, [&order](int) { order += 'a'; });
+    signal.connect(&counter, [&order](int) { order += 'b'; }, false, sigslot::priority{2});
+    signal.connect(&counter, [&order](int) { order += 'c'; }, false, sigslot::priority{1});
+    signal.connect(&counter, [&order](int) { order += 'd'; }, false, sigslot::priority{2});
+    signal(0);
+    EXPECT_EQ(order, "bdca");
+}
+
+TEST(Concurrent, FirstConnect) {
+    // Plain signals and has_slots create their state on first connection; threads racing to
+    // do so must end up sharing one.
+    for (int round = 0; round != 50; ++round) {
+        Counter counter;
+        sigslot::signal<int> signal;
+        std::vector<std::thread> threads;
+        for (int t = 0; t != 4; ++t) {
+            threads.emplace_back([&signal, &counter]() {
+                signal.connect(&counter, &Counter::slot);
+            });
+        }
+        for (auto & t : threads) t.join();
+        signal(1);
+        EXPECT_EQ(counter.count, 4);
+    }
+}
@@ -5,6 +5,9 @@
 #include <gtest/gtest.h>
 #include <sigslot/sigslot.h>
 #include <sigslot/tasklet.h>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace {
     sigslot::tasklet<int> trivial_task(int i) {
@@ -21,7 +24,7 @@ namespace {
         explicit trivial(trivial_flag & f) : flag(f) {
             flag.flag = false;
         }
-        void terminate() const override {
+        void terminate() override {
             flag.flag = true;
         }
     };
@@ -125,4 +128,98 @@ TEST(Tracker, Copy) {
     EXPECT_TRUE(coro.started());
     EXPECT_TRUE(flag.flag);
     EXPECT_EQ(result, 42);
-}
\ No newline at end of file
+}
+
+namespace {
+    sigslot::tasklet<int> st_task(sigslot::st::signal<int> &signal) {
+        co_return co_await signal;
+    }
+}
+
+TEST(Tasklet, SingleThreaded) {
+    sigslot::st::signal<int> signal;
+    auto coro = st_task(signal);
+    coro.start();
+    signal(42);
+    EXPECT_EQ(coro.get(), 42);
+}
+
+namespace {
+    sigslot::tasklet<int> sum_task(sigslot::signal<int> &signal, int count) {
+        int total = 0;
+        for (int i = 0; i != count; ++i) total += co_await signal;
+        co_return total;
+    }
+
+    sigslot::tasklet<std::string> order_task(sigslot::signal<std::string &> &signal, std::string name) {
+        auto & log = co_await signal;
+        log += name;
+        co_return log;
+    }
+
+    sigslot::tasklet<int> pair_task(sigslot::signal<int, std::string const &> &signal) {
+        auto [i, s] = co_await signal;
+        co_return i + static_cast<int>(s.size());
+    }
+}
+
+TEST(Tasklet, Waiters) {
+    sigslot::signal<std::string &> signal;
+    auto a = order_task(signal, "a");
+    auto b = order_task(signal, "b");
+    b.start();
+    a.start();
+    std::string log;
+    signal(log);
+    // Woken in the order they started waiting.
+    EXPECT_EQ(log, "ba");
+    EXPECT_EQ(a.get(), "ba");
+
+    sigslot::signal<int, std::string const &> pair;
+    auto p = pair_task(pair);
+    p.start();
+    pair(1, "four");
+    EXPECT_EQ(p.get(), 5);
+}
+
+TEST(Tasklet, AwaitAgain) {
+    sigslot::signal<int> signal;
+    auto coro = sum_task(signal, 3);
+    coro.start();
+    // Each emission wakes the coroutine once; it waits again for the next.
+    signal(1);
+    signal(2);
+    EXPECT_TRUE(coro.running());
+    signal(3);
+    EXPECT_EQ(coro.get(), 6);
+}
+
+TEST(Tasklet, AwaitAbandoned) {
+    sigslot::signal<int> signal;
+    {
+        auto coro = sum_task(signal, 2);
+        coro.start();
+        signal(1);
+    }
+    // The waiter went with its coroutine.
+    signal(2);
+    auto coro = sum_task(signal, 1);
+    coro.start();
+    signal(3);
+    EXPECT_EQ(coro.get(), 3);
+    // A signal destroyed first leaves its waiters waiting.
+    std::optional<sigslot::signal<int>> gone(std::in_place);
+    auto orphan = sum_task(*gone, 1);
+    orphan.start();
+    gone.reset();
+    EXPECT_TRUE(orphan.running());
+}
+
+TEST(Tasklet, AwaitBatch) {
+    sigslot::signal<int> signal;
+    auto coro = sum_task(signal, 1);
+    coro.start();
+    std::vector<int> events{4, 5, 6};
+    signal.emit_many(events);
+    EXPECT_EQ(coro.get(), 4);
+}
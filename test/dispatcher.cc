@@ -0,0 +1,395 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <sigslot/dispatcher.h>
+#include <sigslot/concurrent.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    class Receiver : public sigslot::has_slots {
+    public:
+        std::vector<std::string> got;
+        void slot(std::string const & s, int i) {
+            got.push_back(s + std::to_string(i));
+        }
+    };
+}
+
+TEST(Dispatcher, Queued) {
+    sigslot::dispatcher queue;
+    Receiver receiver;
+    sigslot::signal<std::string const &, int> signal;
+    signal.connect(&receiver, &Receiver::slot, queue);
+    std::string s = "a";
+    signal(s, 1);
+    s = "b";
+    signal(s, 2);
+    // Nothing happens until the dispatcher is run, and the arguments were copied.
+    EXPECT_TRUE(receiver.got.empty());
+    EXPECT_EQ(queue.depth(), 2u);
+    EXPECT_EQ(queue.dispatch(), 2u);
+    EXPECT_EQ(receiver.got, (std::vector<std::string>{"a1", "b2"}));
+    EXPECT_EQ(queue.depth(), 0u);
+    EXPECT_EQ(queue.dispatched(), 2u);
+}
+
+TEST(Dispatcher, FromThread) {
+    sigslot::dispatcher queue(16);
+    Receiver receiver;
+    sigslot::signal<std::string const &, int> signal;
+    signal.connect<&Receiver::slot>(&receiver, queue);
+    std::thread worker([&signal]() {
+        for (int i = 0; i != 1000; ++i) signal("x", i);
+    });
+    std::size_t n = 0;
+    while (n != 1000) n += queue.dispatch();
+    worker.join();
+    ASSERT_EQ(receiver.got.size(), 1000u);
+    for (int i = 0; i != 1000; ++i) EXPECT_EQ(receiver.got[i], "x" + std::to_string(i));
+    // Emission holds the signal's lock, so overflows rather than wait for room.
+    EXPECT_EQ(queue.dropped(), 0u);
+}
+
+TEST(Dispatcher, ConcurrentFromThread) {
+    // A concurrent_signal's emission holds no lock, so can wait for room.
+    sigslot::dispatcher queue(16);
+    Receiver receiver;
+    sigslot::concurrent_signal<std::string const &, int> signal;
+    signal.connect<&Receiver::slot>(&receiver, queue);
+    std::thread worker([&signal]() {
+        for (int i = 0; i != 1000; ++i) signal("x", i);
+    });
+    std::size_t n = 0;
+    while (n != 1000) n += queue.dispatch();
+    worker.join();
+    ASSERT_EQ(receiver.got.size(), 1000u);
+    EXPECT_EQ(queue.overflowed(), 0u);
+    EXPECT_LE(queue.high_water(), 16u);
+}
+
+TEST(Dispatcher, Disconnected) {
+    sigslot::dispatcher queue;
+    sigslot::signal<int> signal;
+    int total = 0;
+    {
+        Receiver receiver;
+        signal.connect(&receiver, [&total](int i) { total += i; }, queue);
+        signal(1);
+    }
+    auto conn = signal.connect(nullptr, [&total](int i) { total += i * 10; }, queue);
+    signal(2);
+    conn.disconnect();
+    // The first slot's receiver is gone, and the second slot was disconnected.
+    EXPECT_EQ(queue.dispatch(), 2u);
+    EXPECT_EQ(total, 0);
+}
+
+TEST(Dispatcher, OneShot) {
+    sigslot::dispatcher queue;
+    Receiver receiver;
+    sigslot::signal<std::string const &, int> signal;
+    auto conn = signal.connect(&receiver, &Receiver::slot, queue, true);
+    signal("a", 1);
+    signal("b", 2);
+    EXPECT_EQ(queue.depth(), 1u);
+    EXPECT_TRUE(conn.connected());
+    queue.dispatch();
+    EXPECT_FALSE(conn.connected());
+    EXPECT_EQ(receiver.got, (std::vector<std::string>{"a1"}));
+}
+
+TEST(Dispatcher, Copied) {
+    // A copy of the signal has the plain slots, but not those posted to the dispatcher, which
+    // would otherwise share their connection and one-shot state with the original's.
+    sigslot::dispatcher queue;
+    Receiver receiver;
+    sigslot::signal<std::string const &, int> signal;
+    auto conn = signal.connect(&receiver, &Receiver::slot, queue);
+    signal.connect(&receiver, &Receiver::slot, queue, true);
+    signal.connect(&receiver, [&receiver](std::string const & s, int) { receiver.got.push_back(s); });
+    sigslot::signal<std::string const &, int> copy(signal);
+    copy("c", 1);
+    EXPECT_EQ(queue.depth(), 0u);
+    EXPECT_EQ(receiver.got, (std::vector<std::string>{"c"}));
+    conn.disconnect();
+    signal("s", 2);
+    EXPECT_EQ(queue.dispatch(), 1u);
+    EXPECT_EQ(receiver.got, (std::vector<std::string>{"c", "s", "s2"}));
+}
+
+TEST(Dispatcher, Drop) {
+    sigslot::dispatcher queue(4, sigslot::backpressure::drop);
+    int total = 0;
+    for (int i = 0; i != 10; ++i) queue.post([&total, i]() { total += i; });
+    EXPECT_EQ(queue.depth(), 4u);
+    EXPECT_EQ(queue.dropped(), 6u);
+    EXPECT_EQ(queue.high_water(), 4u);
+    queue.dispatch();
+    EXPECT_EQ(total, 0 + 1 + 2 + 3);
+}
+
+TEST(Dispatcher, Grow) {
+    sigslot::dispatcher queue(4, sigslot::backpressure::grow);
+    std::vector<int> order;
+    for (int i = 0; i != 10; ++i) queue.post([&order, i]() { order.push_back(i); });
+    EXPECT_EQ(queue.depth(), 10u);
+    EXPECT_EQ(queue.overflowed(), 6u);
+    EXPECT_EQ(queue.high_water(), 10u);
+    // Partial dispatches keep everything in order, even when more is posted in between.
+    EXPECT_EQ(queue.dispatch(3), 3u);
+    queue.post([&order]() { order.push_back(10); });
+    EXPECT_EQ(queue.dispatch(5), 5u);
+    queue.post([&order]() { order.push_back(11); });
+    EXPECT_EQ(queue.dispatch(), 4u);
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}));
+}
+
+TEST(Dispatcher, Block) {
+    sigslot::dispatcher queue(2, sigslot::backpressure::block);
+    std::vector<int> order;
+    std::vector<std::thread> producers;
+    std::atomic<int> posted = 0;
+    for (int t = 0; t != 4; ++t) {
+        producers.emplace_back([&, t]() {
+            for (int i = 0; i != 250; ++i) {
+                queue.post([&order, t, i]() { order.push_back(t * 1000 + i); });
+                ++posted;
+            }
+        });
+    }
+    std::size_t n = 0;
+    while (n != 1000) n += queue.dispatch();
+    for (auto & p : producers) p.join();
+    EXPECT_EQ(posted, 1000);
+    EXPECT_EQ(queue.dropped(), 0u);
+    EXPECT_EQ(queue.overflowed(), 0u);
+    // Each producer's calls arrive in the order it posted them.
+    std::vector<int> last(4, -1);
+    for (auto v : order) {
+        EXPECT_GT(v % 1000, last[v / 1000]);
+        last[v / 1000] = v % 1000;
+    }
+}
+
+TEST(Dispatcher, BlockFromDispatcher) {
+    // Posting to a full queue from within dispatch() can't wait for itself.
+    sigslot::dispatcher queue(2, sigslot::backpressure::block);
+    int calls = 0;
+    queue.post([&]() {
+        for (int i = 0; i != 4; ++i) queue.post([&calls]() { ++calls; });
+    });
+    queue.dispatch();
+    EXPECT_EQ(calls, 4);
+    EXPECT_EQ(queue.overflowed(), 2u);
+}
+
+TEST(Dispatcher, BlockDuringEmission) {
+    // One-shot calls disconnect from the signal, whose lock an emission holds, so emission
+    // mustn't wait for room in the queue.
+    sigslot::dispatcher queue(2, sigslot::backpressure::block);
+    sigslot::signal<int> signal;
+    std::atomic<int> total = 0;
+    std::vector<sigslot::connection> conns;
+    for (int i = 0; i != 8; ++i) {
+        conns.push_back(signal.connect(nullptr, [&total](int v) { total += v; }, queue, true));
+    }
+    std::atomic<bool> stop = false;
+    std::thread consumer([&]() {
+        while (!stop) queue.dispatch();
+    });
+    std::promise<void> emitted;
+    auto done = emitted.get_future();
+    std::thread emitter([&]() {
+        signal(1);
+        emitted.set_value();
+    });
+    if (done.wait_for(std::chrono::seconds(10)) != std::future_status::ready) {
+        std::fprintf(stderr, "emission deadlocked with one-shot calls\n");
+        std::abort();
+    }
+    emitter.join();
+    while (total != 8) std::this_thread::yield();
+    stop = true;
+    consumer.join();
+    // This emission disconnects any one-shots their calls couldn't.
+    signal(1);
+    EXPECT_EQ(queue.dispatch(), 0u);
+    EXPECT_EQ(total, 8);
+    for (auto & conn : conns) EXPECT_FALSE(conn.connected());
+}
+
+namespace {
+    // A single worker thread, standing in for a thread pool.
+    class Worker {
+    public:
+        Worker() : m_thread([this]() { run(); }) {}
+        ~Worker() {
+            {
+                std::scoped_lock lock(m_mutex);
+                m_stop = true;
+            }
+            m_cv.notify_one();
+            m_thread.join();
+        }
+        void post(std::function<void()> fn) {
+            {
+                std::scoped_lock lock(m_mutex);
+                m_queue.push_back(std::move(fn));
+            }
+            m_cv.notify_one();
+        }
+        std::thread::id id() const {
+            return m_thread.get_id();
+        }
+    private:
+        void run() {
+            for (;;) {
+                std::function<void()> fn;
+                {
+                    std::unique_lock lock(m_mutex);
+                    m_cv.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+                    if (m_queue.empty()) return;
+                    fn = std::move(m_queue.front());
+                    m_queue.erase(m_queue.begin());
+                }
+                fn();
+            }
+        }
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::vector<std::function<void()>> m_queue;
+        bool m_stop = false;
+        std::thread m_thread;
+    };
+
+    // A copyable executor, which just calls things there and then.
+    struct Inline {
+        int * posts;
+        void post(auto && fn) {
+            ++*posts;
+            fn();
+        }
+    };
+
+    class Slow : public sigslot::has_slots {
+    public:
+        std::atomic<bool> started = false;
+        std::atomic<bool> finished = false;
+        std::thread::id ran_on;
+        void slot(int) {
+            ran_on = std::this_thread::get_id();
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            finished = true;
+        }
+    };
+}
+
+static_assert(sigslot::executor<sigslot::dispatcher>);
+static_assert(sigslot::executor<Worker>);
+static_assert(!sigslot::executor<int>);
+
+TEST(Executor, RunsOnExecutor) {
+    Worker worker;
+    sigslot::signal<int> signal;
+    std::atomic<bool> finished = false;
+    {
+        Slow slow;
+        signal.connect(&slow, &Slow::slot, worker);
+        signal(1);
+        while (!slow.started) std::this_thread::yield();
+        EXPECT_EQ(slow.ran_on, worker.id());
+    }
+    Slow other;
+    signal.connect<&Slow::slot>(&other, worker);
+    signal(2);
+    while (!other.finished) std::this_thread::yield();
+    EXPECT_EQ(other.ran_on, worker.id());
+}
+
+TEST(Executor, WaitsForRunning) {
+    Worker worker;
+    sigslot::signal<int> signal;
+    std::atomic<bool> started = false;
+    std::atomic<bool> finished = false;
+    {
+        Slow slow;
+        signal.connect(&slow, [&](int) {
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            finished = true;
+        }, worker);
+        signal(1);
+        while (!started) std::this_thread::yield();
+    }
+    EXPECT_TRUE(finished);
+}
+
+TEST(Executor, SkipsDestroyed) {
+    Worker worker;
+    sigslot::signal<int> signal;
+    std::atomic<int> calls = 0;
+    std::mutex gate;
+    std::unique_lock hold(gate);
+    // Block the worker, so calls pile up behind it.
+    worker.post([&gate]() { std::scoped_lock wait(gate); });
+    {
+        Slow slow;
+        signal.connect(&slow, [&calls](int) { ++calls; }, worker);
+        signal(1);
+        signal(2);
+    }
+    hold.unlock();
+    std::atomic<bool> done = false;
+    worker.post([&done]() { done = true; });
+    while (!done) std::this_thread::yield();
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(Executor, ByValue) {
+    int posts = 0;
+    int total = 0;
+    sigslot::signal<int> signal;
+    Slow slow;
+    signal.connect(&slow, [&total](int i) { total += i; }, Inline{&posts});
+    signal.connect(&slow, [&total](int i) { total += i * 10; }, Inline{&posts}, true);
+    signal(1);
+    signal(2);
+    EXPECT_EQ(posts, 3);
+    EXPECT_EQ(total, 1 + 10 + 2);
+}
+
+TEST(Executor, DestroyFromOwnCall) {
+    Worker worker;
+    sigslot::signal<int> signal;
+    std::atomic<bool> done = false;
+    auto * slow = new Slow;
+    signal.connect(slow, [slow, &done](int) {
+        delete slow;
+        done = true;
+    }, worker);
+    signal(1);
+    while (!done) std::this_thread::yield();
+}
+
+TEST(Executor, Concurrent) {
+    sigslot::dispatcher queue;
+    sigslot::concurrent_signal<int> signal;
+    Slow slow;
+    int total = 0;
+    signal.connect(&slow, [&total](int i) { total += i; }, queue);
+    signal(3);
+    EXPECT_EQ(total, 0);
+    queue.dispatch();
+    EXPECT_EQ(total, 3);
+}
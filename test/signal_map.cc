@@ -0,0 +1,192 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <sigslot/signal_map.h>
+#include <array>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace {
+    class Listener : public sigslot::has_slots {
+    public:
+        std::vector<std::string> got;
+        void slot(int i) {
+            got.push_back(std::to_string(i));
+        }
+    };
+}
+
+TEST(SignalMap, Emit) {
+    sigslot::signal_map<std::string, int> map;
+    Listener a, b;
+    map.connect("a", &a, &Listener::slot);
+    map.connect<&Listener::slot>("b", &b);
+    map.connect("b", &a, [&a](int i) { a.got.push_back("b" + std::to_string(i)); });
+    map.emit("a", 1);
+    map("b", 2);
+    map.emit("c", 3);
+    EXPECT_EQ(a.got, (std::vector<std::string>{"1", "b2"}));
+    EXPECT_EQ(b.got, (std::vector<std::string>{"2"}));
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_FALSE(map.contains("c"));
+}
+
+TEST(SignalMap, Wildcard) {
+    sigslot::signal_map<std::string, int> map;
+    Listener a;
+    std::vector<std::string> any;
+    map.connect("a", &a, &Listener::slot);
+    map.connect_any(&a, [&any](std::string const & key, int i) { any.push_back(key + std::to_string(i)); });
+    map.emit("a", 1);
+    map.emit("b", 2);
+    EXPECT_EQ(a.got, (std::vector<std::string>{"1"}));
+    EXPECT_EQ(any, (std::vector<std::string>{"a1", "b2"}));
+    // Wildcard slots don't count as keys.
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(SignalMap, Forwarding) {
+    sigslot::signal_map<int, std::string> map;
+    Listener a;
+    std::string got;
+    map.connect(1, &a, [&got](std::string s) { got = std::move(s); });
+    // With no wildcard slots, the key's last slot can have the argument moved into it.
+    std::string big(100, 'x');
+    auto data = big.data();
+    map.emit(1, std::move(big));
+    EXPECT_EQ(got.data(), data);
+    std::vector<std::string> any;
+    map.connect_any(&a, [&any](int, std::string s) { any.push_back(std::move(s)); });
+    map.emit(1, "y");
+    EXPECT_EQ(got, "y");
+    EXPECT_EQ(any, (std::vector<std::string>{"y"}));
+}
+
+TEST(SignalMap, EmptyKeysRemoved) {
+    sigslot::signal_map<int, int> map;
+    Listener kept;
+    map.connect(1, &kept, &Listener::slot);
+    {
+        Listener gone;
+        map.connect(2, &gone, &Listener::slot);
+        map.connect(3, &gone, &Listener::slot);
+        map.connect(1, &gone, &Listener::slot);
+        EXPECT_EQ(map.size(), 3u);
+    }
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_TRUE(map.contains(1));
+    map.emit(1, 5);
+    EXPECT_EQ(kept.got, (std::vector<std::string>{"5"}));
+    // One-shot slots take their key with them.
+    map.connect(4, &kept, &Listener::slot, true);
+    EXPECT_TRUE(map.contains(4));
+    map.emit(4, 6);
+    EXPECT_FALSE(map.contains(4));
+    // As do handles.
+    auto conn = map.connect(5, &kept, &Listener::slot);
+    EXPECT_TRUE(map.contains(5));
+    conn.disconnect();
+    EXPECT_FALSE(map.contains(5));
+    map.disconnect(1);
+    EXPECT_EQ(map.size(), 0u);
+    map.emit(1, 7);
+    EXPECT_EQ(kept.got, (std::vector<std::string>{"5", "6"}));
+}
+
+TEST(SignalMap, ManyKeys) {
+    sigslot::signal_map<int, int> map;
+    Listener l;
+    for (int k = 0; k != 1000; ++k) map.connect(k, &l, &Listener::slot);
+    EXPECT_EQ(map.size(), 1000u);
+    // Removing every other key exercises shifting entries back over the gaps.
+    for (int k = 0; k < 1000; k += 2) map.disconnect(k);
+    EXPECT_EQ(map.size(), 500u);
+    for (int k = 0; k != 1000; ++k) {
+        EXPECT_EQ(map.contains(k), k % 2 == 1);
+        map.emit(k, k);
+    }
+    ASSERT_EQ(l.got.size(), 500u);
+    EXPECT_EQ(l.got.front(), "1");
+    EXPECT_EQ(l.got.back(), "999");
+    map.disconnect(&l);
+    EXPECT_EQ(map.size(), 0u);
+}
+
+TEST(SignalMap, ManyKeysDestroyed) {
+    sigslot::signal_map<int, int> map;
+    std::vector<std::unique_ptr<Listener>> listeners;
+    std::vector<sigslot::connection> handles;
+    for (int k = 0; k != 1000; ++k) {
+        listeners.push_back(std::make_unique<Listener>());
+        handles.push_back(map.connect(k, listeners.back().get(), &Listener::slot));
+    }
+    // A second slot keeps key 3 alive through its first listener's destruction.
+    Listener shared;
+    map.connect(3, &shared, &Listener::slot);
+    // Only the keys that lost slots are looked at again, however they lost them.
+    for (int k = 1; k < 1000; k += 4) listeners[k].reset();
+    for (int k = 2; k < 1000; k += 4) handles[k].disconnect();
+    listeners[3].reset();
+    EXPECT_EQ(map.size(), 500u);
+    for (int k = 0; k != 1000; ++k) {
+        EXPECT_EQ(map.contains(k), k % 4 == 0 || k % 4 == 3) << k;
+        map.emit(k, k);
+    }
+    EXPECT_EQ(shared.got, (std::vector<std::string>{"3"}));
+    EXPECT_EQ(listeners[996]->got, (std::vector<std::string>{"996"}));
+}
+
+TEST(SignalMap, ChangesDuringEmit) {
+    sigslot::signal_map<int> map;
+    std::vector<int> order;
+    Listener owner;
+    map.connect(1, &owner, [&]() {
+        order.push_back(1);
+        // Connecting a lot of keys from a slot grows the table mid-emission.
+        for (int k = 100; k != 200; ++k) map.connect(k, &owner, [&order, k]() { order.push_back(k); });
+        map.disconnect(1);
+        map.emit(100);
+    });
+    map.connect(1, &owner, [&order]() { order.push_back(2); });
+    map.emit(1);
+    EXPECT_EQ(order, (std::vector<int>{1, 100}));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.size(), 100u);
+}
+
+TEST(SignalMap, SingleThreaded) {
+    class StListener : public sigslot::st::has_slots {
+    public:
+        int total = 0;
+        void slot(int i) {
+            total += i;
+        }
+    };
+    sigslot::st::signal_map<char const *, int> map;
+    static char const * key = "key";
+    {
+        StListener l;
+        map.connect<&StListener::slot>(key, &l, false, sigslot::priority{1});
+        map.emit(key, 3);
+        EXPECT_EQ(l.total, 3);
+    }
+    EXPECT_FALSE(map.contains(key));
+}
+
+TEST(SignalMap, Resource) {
+    // Nothing beyond the buffer is available, so the table, the keys' signals, and their
+    // connections all have to come from it.
+    std::array<std::byte, 65536> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    sigslot::signal_map<int, int> map(&arena);
+    Listener l;
+    for (int k = 0; k != 20; ++k) map.connect(k, &l, &Listener::slot);
+    map.emit(7, 7);
+    map.disconnect(7);
+    EXPECT_EQ(map.size(), 19u);
+    EXPECT_EQ(l.got, (std::vector<std::string>{"7"}));
+}
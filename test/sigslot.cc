@@ -4,6 +4,12 @@
 
 #include <gtest/gtest.h>
 #include <sigslot/sigslot.h>
+#include <array>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 template<typename ...Args>
 class Sink : public sigslot::has_slots {
@@ -118,3 +124,667 @@ TEST(Simple, test_raii_slot) {
     signal();
     EXPECT_FALSE(sink.result);
 }
+
+TEST(Simple, test_connect_during_emit) {
+    Sink<void> sink1, sink2;
+    sigslot::signal<> signal;
+    signal.connect(&sink1, [&]() {
+        sink1.slot();
+        signal.connect(&sink2, &Sink<void>::slot);
+    }, true);
+    signal();
+    EXPECT_TRUE(sink1.result);
+    EXPECT_FALSE(sink2.result);
+    sink1.reset();
+    signal();
+    EXPECT_FALSE(sink1.result);
+    EXPECT_TRUE(sink2.result);
+}
+
+TEST(Simple, test_disconnect_during_emit) {
+    Sink<void> sink1, sink2, sink3;
+    sigslot::signal<> signal;
+    signal.connect(&sink1, [&]() {
+        sink1.slot();
+        signal.disconnect(&sink2);
+    });
+    signal.connect(&sink2, &Sink<void>::slot);
+    signal.connect(&sink3, &Sink<void>::slot);
+    signal();
+    EXPECT_TRUE(sink1.result);
+    EXPECT_FALSE(sink2.result);
+    EXPECT_TRUE(sink3.result);
+    sink1.reset();
+    sink3.reset();
+    signal();
+    EXPECT_TRUE(sink1.result);
+    EXPECT_FALSE(sink2.result);
+    EXPECT_TRUE(sink3.result);
+}
+
+TEST(Simple, test_destroy_during_emit) {
+    Sink<void> sink1;
+    auto sink2 = std::make_unique<Sink<void>>();
+    sigslot::signal<> signal;
+    signal.connect(&sink1, [&]() {
+        sink1.slot();
+        sink2.reset();
+    });
+    signal.connect(sink2.get(), &Sink<void>::slot);
+    signal();
+    EXPECT_TRUE(sink1.result);
+    EXPECT_FALSE(sink2);
+    sink1.reset();
+    signal();
+    EXPECT_TRUE(sink1.result);
+}
+
+TEST(Simple, test_move_only_slot) {
+    Sink<int> sink;
+    sigslot::signal<int> signal;
+    auto offset = std::make_unique<int>(40);
+    signal.connect(&sink, [&sink, offset = std::move(offset)](int i) {
+        sink.slot(i + *offset);
+    });
+    signal(2);
+    EXPECT_TRUE(sink.result.has_value());
+    EXPECT_EQ(std::get<0>(*sink.result), 42);
+}
+
+TEST(Simple, test_large_slot) {
+    // Too big to fit in place, so this one goes on the heap.
+    std::array<int, 32> big{};
+    big[31] = 40;
+    static_assert(sizeof(big) > SIGSLOT_INPLACE_CAPACITY);
+    Sink<int> sink;
+    sigslot::signal<int> signal;
+    signal.connect(&sink, [&sink, big](int i) {
+        sink.slot(i + big[31]);
+    });
+    signal(2);
+    EXPECT_TRUE(sink.result.has_value());
+    EXPECT_EQ(std::get<0>(*sink.result), 42);
+}
+
+TEST(Simple, test_bound_member) {
+    Sink<bool> sink;
+    sigslot::signal<bool> signal;
+    signal.connect<&Sink<bool>::slot>(&sink);
+    signal(true);
+    EXPECT_TRUE(sink.result.has_value());
+    EXPECT_TRUE(std::get<0>(*sink.result));
+    sink.reset();
+    signal.disconnect(&sink);
+    signal(false);
+    EXPECT_FALSE(sink.result.has_value());
+}
+
+TEST(Simple, test_bound_member_oneshot) {
+    Sink<void> sink;
+    sigslot::signal<> signal;
+    signal.connect<&Sink<void>::slot>(&sink, true);
+    signal();
+    EXPECT_TRUE(sink.result);
+    sink.reset();
+    signal();
+    EXPECT_FALSE(sink.result);
+}
+
+TEST(Simple, test_oneshot_keeps_other_connections) {
+    sigslot::signal<> signal;
+    int once = 0, always = 0;
+    {
+        Sink<void> sink;
+        signal.connect(&sink, [&once]() { ++once; }, true);
+        signal.connect(&sink, [&always]() { ++always; });
+        signal();
+        signal();
+        EXPECT_EQ(once, 1);
+        EXPECT_EQ(always, 2);
+    }
+    // The sink must still have known about the signal when it was destroyed.
+    signal();
+    EXPECT_EQ(always, 2);
+}
+
+TEST(Simple, test_many_connections) {
+    std::array<sigslot::signal<int>, 3> signals;
+    std::vector<std::unique_ptr<Sink<int>>> sinks;
+    for (int i = 0; i != 100; ++i) {
+        auto & sink = sinks.emplace_back(std::make_unique<Sink<int>>());
+        for (auto & signal : signals) signal.connect(sink.get(), &Sink<int>::slot);
+    }
+    // Destroy every other sink, then disconnect a few more by hand.
+    for (int i = 0; i < 100; i += 2) sinks[i].reset();
+    signals[1].disconnect(sinks[1].get());
+    sinks[3]->disconnect_all();
+    for (auto & signal : signals) signal(42);
+    for (int i = 0; i != 100; ++i) {
+        if (!sinks[i]) continue;
+        ASSERT_EQ(sinks[i]->result.has_value(), i != 3) << i;
+        sinks[i]->reset();
+    }
+    // The signals going first leave nothing behind in the sinks.
+    signals[0].disconnect_all();
+    signals[2].disconnect_all();
+    signals[1](7);
+    EXPECT_EQ(std::get<0>(*sinks[5]->result), 7);
+    EXPECT_FALSE(sinks[1]->result.has_value());
+}
+
+namespace {
+    struct Tracked {
+        static inline int copies = 0;
+        static inline int moves = 0;
+        Tracked() = default;
+        Tracked(Tracked const &) { ++copies; }
+        Tracked(Tracked &&) noexcept { ++moves; }
+        static void reset() {
+            copies = moves = 0;
+        }
+    };
+
+    class TrackedSink : public sigslot::has_slots {
+    public:
+        int calls = 0;
+        void by_value(Tracked) { ++calls; }
+        void by_ref(Tracked const &) { ++calls; }
+    };
+}
+
+TEST(Forwarding, test_by_value) {
+    for (int n : {1, 5}) {
+        TrackedSink sink;
+        sigslot::signal<Tracked> signal;
+        for (int i = 0; i != n; ++i) signal.connect(&sink, &TrackedSink::by_value);
+        Tracked t;
+        Tracked::reset();
+        signal(std::move(t));
+        // One copy for every slot but the last, which has the argument moved into it.
+        EXPECT_EQ(Tracked::copies, n - 1) << n;
+        EXPECT_EQ(sink.calls, n);
+        Tracked::reset();
+        signal.emit(t);
+        EXPECT_EQ(Tracked::copies, n) << n;
+    }
+}
+
+TEST(Forwarding, test_unblock_during_emit) {
+    sigslot::signal<std::string> signal;
+    std::vector<std::string> seen;
+    sigslot::connection c;
+    auto a = signal.connect([&c](std::string const &) { c.unblock(); });
+    auto b = signal.connect([&seen](std::string s) { seen.push_back(std::move(s)); });
+    c = signal.connect([&seen](std::string s) { seen.push_back(std::move(s)); }).release();
+    c.block();
+    signal(std::string("not moved from"));
+    // c was blocked when the emission began, so b mustn't have had the argument moved into it.
+    EXPECT_EQ(seen, (std::vector<std::string>{"not moved from", "not moved from"}));
+    c.disconnect();
+}
+
+TEST(Forwarding, test_by_ref) {
+    for (int n : {1, 5}) {
+        TrackedSink sink;
+        sigslot::signal<Tracked const &> signal;
+        for (int i = 0; i != n; ++i) {
+            signal.connect<&TrackedSink::by_ref>(&sink);
+            signal.connect(&sink, [&sink](Tracked const & t) { sink.by_ref(t); });
+        }
+        Tracked t;
+        Tracked::reset();
+        signal(t);
+        EXPECT_EQ(Tracked::copies, 0);
+        EXPECT_EQ(Tracked::moves, 0);
+        EXPECT_EQ(sink.calls, 2 * n);
+    }
+}
+
+TEST(Forwarding, test_by_value_signal_by_ref_slot) {
+    TrackedSink sink;
+    sigslot::signal<Tracked> signal;
+    for (int i = 0; i != 5; ++i) signal.connect(&sink, [&sink](Tracked const & t) { sink.by_ref(t); });
+    Tracked::reset();
+    signal(Tracked{});
+    EXPECT_EQ(Tracked::copies, 0);
+    EXPECT_EQ(sink.calls, 5);
+}
+
+TEST(Batch, test_emit_many) {
+    std::vector<std::string> log;
+    sigslot::signal<std::string const &, int> signal;
+    Sink<std::string, int> sink;
+    signal.connect(&sink, [&log](std::string const & s, int i) { log.push_back("a" + s + std::to_string(i)); });
+    signal.connect(&sink, [&log](std::string const & s, int) { log.push_back("b" + s); });
+    signal.connect(&sink, [&log](std::string const & s, int) { log.push_back("once" + s); }, true);
+    std::vector<std::tuple<std::string, int>> events{{"x", 1}, {"y", 2}};
+    signal.emit_many(events);
+    EXPECT_EQ(log, (std::vector<std::string>{"ax1", "ay2", "bx", "by", "oncex"}));
+    log.clear();
+    signal.emit_many(events, sigslot::emit_order::event_major);
+    EXPECT_EQ(log, (std::vector<std::string>{"ax1", "bx", "ay2", "by"}));
+}
+
+TEST(Batch, test_single_argument) {
+    Sink<int> sink;
+    int total = 0;
+    sigslot::signal<int> signal;
+    auto conn = signal.connect(&sink, [&total](int i) { total += i; });
+    std::array<int, 4> events{1, 2, 3, 4};
+    signal.emit_many(events);
+    EXPECT_EQ(total, 10);
+    // Input ranges that can only be walked once still work.
+    signal.emit_many(std::views::iota(1, 5) | std::views::filter([](int i) { return i % 2; }));
+    EXPECT_EQ(total, 14);
+    signal.emit_many(std::vector<int>{});
+    EXPECT_EQ(total, 14);
+}
+
+TEST(Batch, test_changes_during_batch) {
+    Sink<void> sink1, sink2;
+    int calls = 0;
+    sigslot::signal<int> signal;
+    signal.connect(&sink1, [&](int) {
+        ++calls;
+        signal.disconnect(&sink2);
+        signal.connect(&sink2, [&calls](int) { calls += 100; });
+    });
+    signal.connect(&sink2, [&calls](int) { calls += 10; });
+    std::array<int, 3> events{1, 2, 3};
+    signal.emit_many(events);
+    // sink2's slot is disconnected before it's reached, and its replacement isn't called.
+    EXPECT_EQ(calls, 3);
+    calls = 0;
+    signal.disconnect(&sink1);
+    signal.emit_many(events);
+    EXPECT_EQ(calls, 300);
+}
+
+TEST(Priority, test_order) {
+    std::string order;
+    sigslot::signal<> signal;
+    Sink<void> sink;
+    auto add = [&](char c, int prio) {
+        return signal.connect(&sink, [&order, c]() { order += c; }, false, sigslot::priority{prio});
+    };
+    add('a', 0);
+    add('b', 0);
+    add('c', 10);
+    add('d', -5);
+    add('e', 10);
+    auto f = add('f', 5);
+    signal.connect<&Sink<void>::slot>(&sink);
+    signal();
+    EXPECT_EQ(order, "cefabd");
+    EXPECT_TRUE(sink.result);
+    // Positions are kept track of through insertions, so disconnection finds the right slot.
+    f.disconnect();
+    order.clear();
+    signal();
+    EXPECT_EQ(order, "ceabd");
+}
+
+TEST(Priority, test_connect_during_emit) {
+    std::string order;
+    sigslot::signal<> signal;
+    Sink<void> sink;
+    bool once = true;
+    signal.connect(&sink, [&]() {
+        order += 'a';
+        if (!once) return;
+        once = false;
+        signal.connect(&sink, [&order]() { order += 'x'; }, false, sigslot::priority{1});
+        signal.connect(&sink, [&order]() { order += 'y'; }, false, sigslot::priority{-1});
+        signal.connect(&sink, [&order]() { order += 'z'; }, false, sigslot::priority{1});
+    });
+    auto b = signal.connect(&sink, [&order]() { order += 'b'; });
+    signal();
+    EXPECT_EQ(order, "ab");
+    order.clear();
+    signal();
+    EXPECT_EQ(order, "xzaby");
+    b.disconnect();
+    order.clear();
+    signal();
+    EXPECT_EQ(order, "xzay");
+}
+
+TEST(Result, test_combiners) {
+    sigslot::signal<int(int)> signal;
+    auto empty = signal(1);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(signal.emit<sigslot::combiners::maximum>(1).has_value());
+    EXPECT_TRUE(signal.emit<sigslot::combiners::all_true>(1));
+    auto a = signal.connect([](int i) { return i; });
+    auto b = signal.connect([](int i) { return i * 3; });
+    auto c = signal.connect([](int i) { return i - 5; });
+    auto all = signal(2);
+    ASSERT_EQ(all.size(), 3u);
+    EXPECT_EQ(all[0], 2);
+    EXPECT_EQ(all[1], 6);
+    EXPECT_EQ(all[2], -3);
+    EXPECT_EQ(signal.emit<sigslot::combiners::sum>(2), 5);
+    EXPECT_EQ(signal.emit<sigslot::combiners::maximum>(2), 6);
+    EXPECT_FALSE(signal.emit<sigslot::combiners::all_true>(5));
+    EXPECT_TRUE(signal.emit<sigslot::combiners::all_true>(6));
+    auto many = signal.combine(sigslot::combiners::collect<int, 2>{}, 1);
+    EXPECT_EQ(many.size(), 3u);
+    EXPECT_FALSE(many.is_inline());
+    auto copy = many;
+    EXPECT_EQ(copy[2], -4);
+}
+
+TEST(Result, test_short_circuit) {
+    std::string called;
+    sigslot::signal<std::string const *(std::string const &)> route;
+    Sink<void> sink;
+    std::array<std::string, 3> names{"alpha", "beta", "gamma"};
+    for (auto const & name : names) {
+        route.connect(&sink, [&called, &name](std::string const & msg) -> std::string const * {
+            called += name[0];
+            return msg == name ? &name : nullptr;
+        });
+    }
+    auto once = route.connect(&sink, [&called](std::string const &) -> std::string const * {
+        called += 'z';
+        return nullptr;
+    }, true);
+    EXPECT_EQ(route.emit<sigslot::combiners::first_non_empty>("beta"), &names[1]);
+    EXPECT_EQ(called, "ab");
+    // The one-shot slot wasn't reached, so is still there.
+    EXPECT_TRUE(once.connected());
+    called.clear();
+    EXPECT_EQ(route.emit<sigslot::combiners::first_non_empty>("delta"), nullptr);
+    EXPECT_EQ(called, "abgz");
+    EXPECT_FALSE(once.connected());
+    // A higher priority slot gets first refusal.
+    route.connect(&sink, [](std::string const &) -> std::string const * { return nullptr; }, false, sigslot::priority{1});
+    route.connect(&sink, [&names](std::string const &) { return &names[2]; }, false, sigslot::priority{1});
+    called.clear();
+    EXPECT_EQ(route.emit<sigslot::combiners::first_non_empty>("alpha"), &names[2]);
+    EXPECT_EQ(called, "");
+}
+
+TEST(Result, test_member) {
+    class Handler : public sigslot::has_slots {
+    public:
+        bool handle(int i) {
+            return i > 0;
+        }
+    };
+    sigslot::signal<bool(int)> signal;
+    {
+        Handler handler;
+        signal.connect(&handler, &Handler::handle);
+        signal.connect<&Handler::handle>(&handler);
+        EXPECT_TRUE(signal.emit<sigslot::combiners::all_true>(1));
+        EXPECT_EQ(signal(-1).size(), 2u);
+    }
+    EXPECT_TRUE(signal(1).empty());
+}
+
+TEST(Connection, test_disconnect) {
+    Sink<int> sink;
+    sigslot::signal<int> signal;
+    auto conn = signal.connect(&sink, &Sink<int>::slot);
+    signal.connect(&sink, [](int) {});
+    EXPECT_TRUE(conn.connected());
+    conn.disconnect();
+    EXPECT_FALSE(conn.connected());
+    signal(1);
+    EXPECT_FALSE(sink.result.has_value());
+    conn.disconnect();
+    sigslot::connection empty;
+    EXPECT_FALSE(empty.connected());
+    empty.disconnect();
+}
+
+TEST(Connection, test_block) {
+    Sink<int> sink;
+    sigslot::signal<int> signal;
+    auto conn = signal.connect<&Sink<int>::slot>(&sink, true);
+    conn.block();
+    EXPECT_TRUE(conn.blocked());
+    signal(1);
+    EXPECT_FALSE(sink.result.has_value());
+    conn.unblock();
+    signal(2);
+    EXPECT_EQ(std::get<0>(*sink.result), 2);
+    // One-shot, so that's it.
+    EXPECT_FALSE(conn.connected());
+}
+
+TEST(Connection, test_outlives) {
+    sigslot::connection conn;
+    {
+        sigslot::signal<int> signal;
+        Sink<int> sink;
+        conn = signal.connect(&sink, &Sink<int>::slot);
+    }
+    EXPECT_FALSE(conn.connected());
+    conn.disconnect();
+    conn.block();
+    sigslot::signal<int> signal;
+    {
+        Sink<int> sink;
+        conn = signal.connect(&sink, &Sink<int>::slot);
+    }
+    EXPECT_FALSE(conn.connected());
+}
+
+TEST(Connection, test_scoped) {
+    int count = 0;
+    sigslot::signal<> signal;
+    sigslot::connection kept;
+    {
+        sigslot::scoped_connection outer;
+        {
+            auto inner = signal.connect([&count]() { ++count; });
+            signal();
+            outer = std::move(inner);
+        }
+        signal();
+        auto another = signal.connect([&count]() { count += 10; });
+        kept = another.release();
+        signal();
+    }
+    signal();
+    EXPECT_EQ(count, 1 + 1 + 11 + 10);
+    EXPECT_TRUE(kept.connected());
+    kept.disconnect();
+    signal();
+    EXPECT_EQ(count, 23);
+}
+
+TEST(Connection, test_disconnect_self) {
+    int count = 0;
+    sigslot::signal<> signal;
+    sigslot::connection conn;
+    conn = signal.connect(nullptr, [&]() {
+        ++count;
+        conn.disconnect();
+    });
+    signal();
+    signal();
+    EXPECT_EQ(count, 1);
+}
+
+namespace {
+    // Counts what passes through it on the way to the heap.
+    class counting_resource : public std::pmr::memory_resource {
+    public:
+        std::size_t allocations = 0;
+        std::size_t outstanding = 0;
+
+    private:
+        void * do_allocate(std::size_t bytes, std::size_t align) override {
+            ++allocations;
+            ++outstanding;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+        void do_deallocate(void * p, std::size_t bytes, std::size_t align) override {
+            --outstanding;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+        bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override {
+            return this == &other;
+        }
+    };
+}
+
+TEST(Resource, test_counted) {
+    counting_resource counted;
+    std::array<int, 32> big{};
+    big[31] = 40;
+    sigslot::connection conn;
+    {
+        sigslot::signal<int> signal(&counted);
+        EXPECT_EQ(signal.resource(), &counted);
+        Sink<int> sink;
+        signal.connect(&sink, &Sink<int>::slot);
+        auto before = counted.allocations;
+        conn = signal.connect(&sink, [&sink, big](int i) { sink.slot(i + big[31]); });
+        // The connection, and the function object too big to fit in place.
+        EXPECT_GE(counted.allocations, before + 2);
+        signal(2);
+        EXPECT_EQ(std::get<0>(*sink.result), 42);
+        // Copies go to the default resource, as with std::pmr containers.
+        auto copied = counted.allocations;
+        sigslot::signal<int> copy(signal);
+        EXPECT_EQ(copy.resource(), std::pmr::get_default_resource());
+        EXPECT_EQ(counted.allocations, copied);
+        copy(1);
+        EXPECT_EQ(std::get<0>(*sink.result), 41);
+    }
+    // The handle still holds its connection.
+    EXPECT_EQ(counted.outstanding, 1u);
+    conn = {};
+    EXPECT_EQ(counted.outstanding, 0u);
+}
+
+TEST(Resource, test_arena) {
+    // Nothing beyond the buffer is available, so every allocation has to come from it.
+    std::array<std::byte, 8192> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    std::array<int, 32> big{};
+    int total = 0;
+    sigslot::signal<int> signal(&arena);
+    Sink<int> sink;
+    for (int i = 0; i != 8; ++i) {
+        signal.connect(&sink, [&total](int v) { total += v; }, i % 2 == 0, sigslot::priority{i});
+    }
+    signal.connect(&sink, [&total, big](int v) { total += v + big[0]; });
+    signal(1);
+    signal(1);
+    EXPECT_EQ(total, 9 + 5);
+}
+
+TEST(Resource, test_default) {
+    counting_resource counted;
+    auto previous = std::pmr::set_default_resource(&counted);
+    {
+        sigslot::signal<int> signal;
+        Sink<int> sink;
+        signal.connect(&sink, &Sink<int>::slot);
+        signal.connect<&Sink<int>::slot>(&sink, true);
+        auto conn = signal.connect(&sink, &Sink<int>::slot);
+        EXPECT_GT(counted.allocations, 0u);
+        signal(3);
+        EXPECT_EQ(std::get<0>(*sink.result), 3);
+        conn.disconnect();
+        signal.disconnect(&sink);
+        signal(4);
+        EXPECT_EQ(std::get<0>(*sink.result), 3);
+    }
+    std::pmr::set_default_resource(previous);
+    EXPECT_EQ(counted.outstanding, 0u);
+}
+
+TEST(Resource, test_copy_move_only) {
+    // Copying a move-only slot throws, and mustn't leak what was allocated for its copy.
+    counting_resource counted;
+    auto previous = std::pmr::set_default_resource(&counted);
+    {
+        sigslot::signal<int> signal;
+        Sink<int> sink;
+        signal.connect(&sink, &Sink<int>::slot);
+        signal.connect(&sink, [offset = std::make_unique<int>(40)](int) {});
+        EXPECT_THROW(sigslot::signal<int> copy(signal), std::logic_error);
+        signal(3);
+        EXPECT_EQ(std::get<0>(*sink.result), 3);
+    }
+    std::pmr::set_default_resource(previous);
+    EXPECT_EQ(counted.outstanding, 0u);
+}
+
+TEST(Resource, test_awaitable) {
+    // Awaiting a signal creates its state, from its resource, but waiting allocates nothing.
+    counting_resource counted;
+    {
+        sigslot::signal<int> signal(&counted);
+        auto awaitable = signal.operator co_await();
+        auto allocations = counted.allocations;
+        EXPECT_GT(allocations, 0u);
+        EXPECT_FALSE(awaitable.await_ready());
+        awaitable.await_suspend(std::noop_coroutine());
+        EXPECT_EQ(counted.allocations, allocations);
+        signal(5);
+        EXPECT_TRUE(awaitable.await_ready());
+        EXPECT_EQ(awaitable.await_resume(), 5);
+    }
+    EXPECT_EQ(counted.outstanding, 0u);
+}
+
+TEST(SingleThreaded, test_st) {
+    class StSink : public sigslot::st::has_slots {
+    public:
+        int count = 0;
+        void slot(int i) {
+            count += i;
+        }
+    };
+    sigslot::st::signal<int> signal;
+    {
+        StSink sink;
+        signal.connect(&sink, &StSink::slot);
+        signal.connect<&StSink::slot>(&sink, true);
+        signal(2);
+        signal(3);
+        EXPECT_EQ(sink.count, 7);
+    }
+    signal(4);
+}
+
+// Objects that are never connected should cost as little as possible; these catch any
+// growth.
+static_assert(sizeof(sigslot::signal<>) == sizeof(void *));
+static_assert(sizeof(sigslot::signal<int, std::string const &>) == sizeof(void *));
+static_assert(sizeof(sigslot::signal<bool(int)>) == sizeof(void *));
+static_assert(sizeof(sigslot::st::signal<int>) == sizeof(void *));
+static_assert(sizeof(sigslot::has_slots) == 2 * sizeof(void *));
+static_assert(sizeof(sigslot::st::has_slots) == 2 * sizeof(void *));
+
+TEST(Footprint, test_idle) {
+    // Nothing is allocated until something's connected.
+    counting_resource counted;
+    auto previous = std::pmr::set_default_resource(&counted);
+    {
+        std::vector<sigslot::signal<int>> signals(100);
+        std::vector<Sink<int>> sinks(100);
+        auto baseline = counted.allocations;
+        for (auto & signal : signals) {
+            signal(1);
+            signal.disconnect(&sinks.front());
+            signal.disconnect_all();
+        }
+        for (auto & sink : sinks) sink.disconnect_all();
+        EXPECT_EQ(counted.allocations, baseline);
+        signals[0].connect(&sinks[0], &Sink<int>::slot);
+        EXPECT_GT(counted.allocations, baseline);
+        signals[0](2);
+        EXPECT_EQ(std::get<0>(*sinks[0].result), 2);
+        EXPECT_FALSE(sinks[1].result.has_value());
+    }
+    std::pmr::set_default_resource(previous);
+    EXPECT_EQ(counted.outstanding, 0u);
+}
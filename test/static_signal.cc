@@ -0,0 +1,213 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <sigslot/static_signal.h>
+#include <sigslot/tasklet.h>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace {
+    class Sink : public sigslot::has_slots {
+    public:
+        int count = 0;
+        std::string log;
+        void slot(int i) {
+            count += i;
+        }
+        void named(std::string const & s) {
+            log += s;
+        }
+    };
+
+    sigslot::tasklet<int> await_int(sigslot::static_signal<2, int> & signal) {
+        co_return co_await signal;
+    }
+
+    sigslot::tasklet<std::string> await_pair(sigslot::static_signal<1, int, std::string const &> & signal) {
+        auto [i, s] = co_await signal;
+        co_return s + std::to_string(i);
+    }
+}
+
+TEST(StaticSignal, Simple) {
+    Sink a, b;
+    sigslot::static_signal<2, int> signal;
+    EXPECT_EQ(signal.capacity(), 2u);
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&a));
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&b));
+    EXPECT_EQ(signal.size(), 2u);
+    signal(3);
+    EXPECT_EQ(a.count, 3);
+    EXPECT_EQ(b.count, 3);
+    signal.disconnect(&a);
+    signal(1);
+    EXPECT_EQ(a.count, 3);
+    EXPECT_EQ(b.count, 4);
+    EXPECT_EQ(signal.size(), 1u);
+}
+
+TEST(StaticSignal, Full) {
+    Sink a;
+    sigslot::static_signal<2, int> signal;
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&a));
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&a));
+    EXPECT_FALSE(signal.connect<&Sink::slot>(&a));
+    signal(1);
+    EXPECT_EQ(a.count, 2);
+    signal.disconnect(&a);
+    EXPECT_EQ(signal.size(), 0u);
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&a));
+}
+
+TEST(StaticSignal, Order) {
+    Sink a, b, c;
+    sigslot::static_signal<3, std::string const &> signal;
+    std::string log;
+    auto note = [](void * ctx, std::string const & s) { *static_cast<std::string *>(ctx) += s; };
+    EXPECT_TRUE(signal.connect(nullptr, note, &log));
+    EXPECT_TRUE(signal.connect<&Sink::named>(&a));
+    EXPECT_TRUE(signal.connect(nullptr, note, &log));
+    signal("x");
+    EXPECT_EQ(log, "xx");
+    signal.disconnect(note, &log);
+    EXPECT_EQ(signal.size(), 1u);
+    // The freed places are reused, but order is still connection order.
+    EXPECT_TRUE(signal.connect<&Sink::named>(&b));
+    EXPECT_TRUE(signal.connect<&Sink::named>(&c));
+    std::string order;
+    auto mark = [](void * ctx, std::string const &) { *static_cast<std::string *>(ctx) += "!"; };
+    EXPECT_FALSE(signal.connect(nullptr, mark, &order));
+    signal("y");
+    EXPECT_EQ(a.log, "xy");
+    EXPECT_EQ(b.log, "y");
+    EXPECT_EQ(c.log, "y");
+}
+
+TEST(StaticSignal, SlotFunction) {
+    sigslot::static_signal<1, int, std::string, std::string const &> signal;
+    static_assert(std::is_same_v<decltype(signal)::slot_function, void (*)(void *, int, std::string &, std::string const &)>);
+    static_assert(std::is_same_v<sigslot::static_slot_arg<std::string>, std::string &>);
+    std::string log;
+    auto fn = [](void * ctx, sigslot::static_slot_arg<int> i, sigslot::static_slot_arg<std::string> s, sigslot::static_slot_arg<std::string const &> t) {
+        *static_cast<std::string *>(ctx) += std::to_string(i) + s + t;
+    };
+    EXPECT_TRUE(signal.connect(nullptr, fn, &log));
+    signal(1, "a", "b");
+    EXPECT_EQ(log, "1ab");
+}
+
+TEST(StaticSignal, Lifetime) {
+    sigslot::static_signal<2, int> signal;
+    {
+        Sink a;
+        EXPECT_TRUE(signal.connect<&Sink::slot>(&a));
+        signal(1);
+        EXPECT_EQ(a.count, 1);
+    }
+    EXPECT_EQ(signal.size(), 0u);
+    signal(1);
+    Sink b;
+    {
+        sigslot::static_signal<1, int> inner;
+        EXPECT_TRUE(inner.connect<&Sink::slot>(&b));
+    }
+    // The has_slots has nothing left to disconnect.
+    b.disconnect_all();
+}
+
+TEST(StaticSignal, SlotsDestroyedFirst) {
+    sigslot::static_signal<1, int> signal;
+    Sink b;
+    {
+        Sink a;
+        EXPECT_TRUE(signal.connect<&Sink::slot>(&a));
+        signal(1);
+    }
+    signal(2);
+    // The place a's connection had is free again, and b's link is untouched by a's going.
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&b));
+    {
+        Sink c;
+        EXPECT_FALSE(signal.connect<&Sink::slot>(&c));
+    }
+    signal(3);
+    EXPECT_EQ(b.count, 3);
+    b.disconnect_all();
+    EXPECT_EQ(signal.size(), 0u);
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&b));
+}
+
+TEST(StaticSignal, OneShot) {
+    Sink a;
+    sigslot::static_signal<1, int> signal;
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&a, true));
+    signal(1);
+    signal(1);
+    EXPECT_EQ(a.count, 1);
+    EXPECT_EQ(signal.size(), 0u);
+}
+
+TEST(StaticSignal, DuringEmission) {
+    sigslot::static_signal<2, int> signal;
+    struct Reconnect : sigslot::has_slots {
+        sigslot::static_signal<2, int> * signal;
+        Sink * other;
+        int calls = 0;
+        void slot(int) {
+            ++calls;
+            signal->disconnect(other);
+            // Still full, until the emission has finished.
+            EXPECT_FALSE(signal->connect<&Sink::slot>(other));
+        }
+    };
+    Sink other;
+    Reconnect r;
+    r.signal = &signal;
+    r.other = &other;
+    EXPECT_TRUE(signal.connect<&Reconnect::slot>(&r));
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&other));
+    signal(1);
+    EXPECT_EQ(r.calls, 1);
+    EXPECT_EQ(other.count, 0);
+    EXPECT_EQ(signal.size(), 1u);
+}
+
+TEST(StaticSignal, Await) {
+    sigslot::static_signal<2, int> signal;
+    auto task = await_int(signal);
+    task.start();
+    EXPECT_EQ(signal.size(), 1u);
+    signal(42);
+    EXPECT_EQ(task.get(), 42);
+    EXPECT_EQ(signal.size(), 0u);
+
+    sigslot::static_signal<1, int, std::string const &> pair;
+    auto pair_task = await_pair(pair);
+    pair_task.start();
+    pair(7, "seven ");
+    EXPECT_EQ(pair_task.get(), "seven 7");
+}
+
+TEST(StaticSignal, AwaitFull) {
+    Sink a, b;
+    sigslot::static_signal<2, int> signal;
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&a));
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&b));
+    auto task = await_int(signal);
+    task.start();
+    EXPECT_THROW(task.get(), std::length_error);
+}
+
+TEST(StaticSignal, AwaitAbandoned) {
+    sigslot::static_signal<2, int> signal;
+    {
+        auto task = await_int(signal);
+        task.start();
+        EXPECT_EQ(signal.size(), 1u);
+    }
+    EXPECT_EQ(signal.size(), 0u);
+    signal(1);
+}
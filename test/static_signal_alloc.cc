@@ -0,0 +1,57 @@
+//
+// Created by dwd on 16/10/2026.
+//
+// Checks static_signal never allocates, by counting allocations through a replaced global
+// operator new - which is why it's a test executable of its own.
+//
+
+#include <gtest/gtest.h>
+#include <sigslot/static_signal.h>
+#include <cstdlib>
+#include <new>
+
+// Counts allocations on this thread, so tests can check there are none.
+namespace {
+    thread_local std::size_t allocations = 0;
+}
+
+void * operator new(std::size_t size) {
+    ++allocations;
+    if (auto p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    class Sink : public sigslot::has_slots {
+    public:
+        int count = 0;
+        void slot(int i) {
+            count += i;
+        }
+    };
+}
+
+TEST(StaticSignal, NoAllocation) {
+    Sink a, b;
+    sigslot::static_signal<4, int> signal;
+    // Each has_slots allocates its bookkeeping on its first connection to anything.
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&a));
+    EXPECT_TRUE(signal.connect<&Sink::slot>(&b));
+    auto before = allocations;
+    for (int i = 0; i != 100; ++i) {
+        signal(1);
+        signal.disconnect(&b);
+        EXPECT_TRUE(signal.connect<&Sink::slot>(&b, true));
+    }
+    EXPECT_EQ(allocations, before);
+    EXPECT_EQ(a.count, 100);
+    EXPECT_EQ(b.count, 100);
+}
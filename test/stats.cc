@@ -0,0 +1,138 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <sigslot/sigslot.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    class Counter : public sigslot::has_slots {
+    public:
+        int count = 0;
+        void slot(int i) {
+            count += i;
+        }
+    };
+
+    std::optional<sigslot::signal_statistics> find(std::string const & name) {
+        for (auto & s : sigslot::instrumentation::snapshot()) {
+            if (s.name == name) return s;
+        }
+        return std::nullopt;
+    }
+}
+
+TEST(Stats, Histogram) {
+    sigslot::latency_histogram h;
+    EXPECT_EQ(h.percentile(0.5), 0u);
+    for (std::uint64_t v = 1; v <= 1000; ++v) h.record(v * 1000);
+    EXPECT_EQ(h.count(), 1000u);
+    EXPECT_EQ(h.max(), 1000000u);
+    EXPECT_EQ(h.mean(), 500500u);
+    // Each value is recorded to within an eighth.
+    for (auto p : {0.01, 0.5, 0.9, 0.99}) {
+        auto expected = static_cast<double>(p * 1000000);
+        EXPECT_GE(static_cast<double>(h.percentile(p)), expected);
+        EXPECT_LE(static_cast<double>(h.percentile(p)), expected * 1.125);
+    }
+    EXPECT_EQ(h.percentile(1.0), 1000000u);
+    for (std::uint64_t v : {0ull, 7ull, 8ull, 9ull, 1000ull, 123456789ull}) {
+        EXPECT_GE(sigslot::latency_histogram::highest(sigslot::latency_histogram::bucket(v)), v);
+    }
+    EXPECT_EQ(sigslot::latency_histogram::bucket(~0ull), sigslot::latency_histogram::buckets - 1);
+}
+
+TEST(Stats, Counters) {
+    Counter a, b;
+    sigslot::signal<int> signal;
+    signal.connect(&a, &Counter::slot);
+    EXPECT_FALSE(signal.instrumented());
+    signal(1);
+    signal.instrument("stats.counters");
+    EXPECT_TRUE(signal.instrumented());
+    signal.connect<&Counter::slot>(&b);
+    signal.connect(&b, &Counter::slot, true);
+    signal(1);
+    signal(1);
+    signal(1);
+    auto s = find("stats.counters");
+    ASSERT_TRUE(s);
+    EXPECT_EQ(s->emits, 3u);
+    EXPECT_EQ(s->slot_calls, 7u);
+    EXPECT_EQ(s->one_shot_expiries, 1u);
+    EXPECT_EQ(s->latency.count(), 7u);
+    EXPECT_EQ(s->lock_wait.count(), 3u);
+    // The one-shot slot has gone.
+    ASSERT_EQ(s->slots.size(), 2u);
+    EXPECT_EQ(s->slots[0].dest, static_cast<sigslot::has_slots *>(&a));
+    EXPECT_EQ(s->slots[0].latency.count(), 3u);
+    EXPECT_EQ(s->slots[1].dest, static_cast<sigslot::has_slots *>(&b));
+    EXPECT_LT(s->slots[0].id, s->slots[1].id);
+    signal.disconnect(&a);
+    EXPECT_EQ(find("stats.counters")->slots.size(), 1u);
+    signal.instrument("stats.renamed");
+    EXPECT_FALSE(find("stats.counters"));
+    EXPECT_EQ(find("stats.renamed")->emits, 3u);
+}
+
+TEST(Stats, Batch) {
+    Counter a;
+    sigslot::signal<int> signal;
+    signal.instrument("stats.batch");
+    signal.connect(&a, &Counter::slot);
+    std::vector<int> events{1, 2, 3};
+    signal.emit_many(events);
+    signal.emit_many(events, sigslot::emit_order::event_major);
+    EXPECT_EQ(a.count, 12);
+    auto s = find("stats.batch");
+    ASSERT_TRUE(s);
+    EXPECT_EQ(s->emits, 6u);
+    EXPECT_EQ(s->slot_calls, 6u);
+    EXPECT_EQ(s->lock_wait.count(), 2u);
+}
+
+TEST(Stats, Result) {
+    sigslot::signal<int(int)> signal;
+    signal.instrument("stats.result");
+    auto c1 = signal.connect([](int i) { return i; });
+    auto c2 = signal.connect([](int i) { return i * 2; });
+    EXPECT_EQ(signal.emit<sigslot::combiners::sum>(3), 9);
+    EXPECT_EQ(find("stats.result")->slot_calls, 2u);
+}
+
+TEST(Stats, SlowSlot) {
+    std::vector<std::string> slow;
+    sigslot::instrumentation::on_slow_slot(std::chrono::milliseconds(1), [&slow](sigslot::slow_slot const & s) {
+        slow.emplace_back(s.signal);
+        EXPECT_GT(s.elapsed, std::chrono::milliseconds(1));
+    });
+    Counter fast;
+    sigslot::signal<int> signal;
+    signal.instrument("stats.slow");
+    signal.connect(&fast, &Counter::slot);
+    signal.connect(&fast, [](int) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+    signal(1);
+    sigslot::instrumentation::on_slow_slot({}, {});
+    signal(1);
+    EXPECT_EQ(slow, (std::vector<std::string>{"stats.slow"}));
+    EXPECT_EQ(find("stats.slow")->slow_calls, 1u);
+}
+
+TEST(Stats, Lifetime) {
+    {
+        sigslot::signal<> signal;
+        signal.instrument("stats.lifetime");
+        EXPECT_TRUE(find("stats.lifetime"));
+    }
+    EXPECT_FALSE(find("stats.lifetime"));
+    sigslot::signal<> plain;
+    plain.connect([]() {}).release();
+    auto count = sigslot::instrumentation::snapshot().size();
+    plain();
+    EXPECT_EQ(sigslot::instrumentation::snapshot().size(), count);
+}
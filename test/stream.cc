@@ -0,0 +1,134 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <sigslot/sigslot.h>
+#include <sigslot/stream.h>
+#include <sigslot/tasklet.h>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+    sigslot::tasklet<int> sum_stream(sigslot::signal<int> & signal, std::size_t capacity) {
+        auto events = signal.stream(capacity);
+        int total = 0;
+        while (auto ev = co_await events.next()) {
+            if (*ev < 0) break;
+            total += *ev;
+        }
+        co_return total;
+    }
+
+    sigslot::tasklet<std::size_t> batches(sigslot::basic_signal_stream<sigslot::multi_threaded_local, int> & events, std::vector<int> & seen) {
+        std::size_t resumes = 0;
+        while (co_await events.ready()) {
+            ++resumes;
+            events.drain([&seen](int i) { seen.push_back(i); });
+        }
+        co_return resumes;
+    }
+}
+
+TEST(Stream, Buffered) {
+    sigslot::signal<int> signal;
+    // Emissions made while nothing's awaiting are kept.
+    auto events = signal.stream(4);
+    signal(1);
+    signal(2);
+    EXPECT_EQ(events.size(), 2u);
+    EXPECT_EQ(events.try_next(), 1);
+    EXPECT_EQ(events.try_next(), 2);
+    EXPECT_FALSE(events.try_next());
+}
+
+TEST(Stream, Await) {
+    sigslot::signal<int> signal;
+    auto task = sum_stream(signal, 4);
+    task.start();
+    signal(1);
+    signal(2);
+    signal(3);
+    EXPECT_TRUE(task.running());
+    signal(-1);
+    EXPECT_EQ(task.get(), 6);
+    // The stream went with the coroutine.
+    signal(1);
+}
+
+TEST(Stream, DropOldest) {
+    sigslot::signal<int> signal;
+    auto events = signal.stream(2, sigslot::stream_overflow::drop_oldest);
+    for (int i = 1; i <= 5; ++i) signal(i);
+    EXPECT_EQ(events.dropped(), 3u);
+    EXPECT_EQ(events.try_next(), 4);
+    EXPECT_EQ(events.try_next(), 5);
+    EXPECT_FALSE(events.try_next());
+}
+
+TEST(Stream, DropNewest) {
+    sigslot::signal<int> signal;
+    auto events = signal.stream(2, sigslot::stream_overflow::drop_newest);
+    for (int i = 1; i <= 5; ++i) signal(i);
+    EXPECT_EQ(events.dropped(), 3u);
+    EXPECT_EQ(events.try_next(), 1);
+    EXPECT_EQ(events.try_next(), 2);
+    EXPECT_FALSE(events.try_next());
+}
+
+TEST(Stream, Grow) {
+    sigslot::signal<int> signal;
+    auto events = signal.stream(2, sigslot::stream_overflow::grow);
+    for (int i = 1; i <= 5; ++i) signal(i);
+    EXPECT_EQ(events.dropped(), 0u);
+    EXPECT_EQ(events.overflowed(), 3u);
+    EXPECT_EQ(events.size(), 5u);
+    EXPECT_EQ(events.try_next(), 1);
+    signal(6);
+    std::vector<int> seen;
+    EXPECT_EQ(events.drain([&seen](int i) { seen.push_back(i); }), 5u);
+    EXPECT_EQ(seen, (std::vector<int>{2, 3, 4, 5, 6}));
+}
+
+TEST(Stream, Batch) {
+    sigslot::signal<int> signal;
+    auto events = signal.stream(8);
+    std::vector<int> seen;
+    auto task = batches(events, seen);
+    signal(1);
+    signal(2);
+    // Started with two buffered, so both are handled in one go.
+    task.start();
+    EXPECT_EQ(seen, (std::vector<int>{1, 2}));
+    signal(3);
+    EXPECT_EQ(seen, (std::vector<int>{1, 2, 3}));
+    events.close();
+    EXPECT_EQ(task.get(), 2u);
+    // Closed, so no longer subscribed.
+    signal(4);
+    EXPECT_EQ(events.size(), 0u);
+}
+
+TEST(Stream, Tuple) {
+    sigslot::signal<int, std::string const &> signal;
+    auto events = signal.stream(2);
+    std::string s = "one";
+    signal(1, s);
+    s = "changed";
+    // Arguments are copied, references included.
+    EXPECT_EQ(events.try_next(), std::make_tuple(1, std::string("one")));
+}
+
+TEST(Stream, Threads) {
+    sigslot::signal<int> signal;
+    auto events = signal.stream(16, sigslot::stream_overflow::grow);
+    std::thread producer([&signal]() {
+        for (int i = 0; i != 1000; ++i) signal(1);
+    });
+    producer.join();
+    int total = 0;
+    events.drain([&total](int i) { total += i; });
+    EXPECT_EQ(total, 1000);
+}
@@ -0,0 +1,123 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <sigslot/sigslot.h>
+#include <sigslot/tasklet.h>
+#include <sigslot/trace.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+    class Counter : public sigslot::has_slots {
+    public:
+        int count = 0;
+        void slot(int i) {
+            count += i;
+        }
+    };
+
+    sigslot::tasklet<int> waiting_task(sigslot::signal<int> & signal) {
+        co_return co_await signal;
+    }
+
+    std::string written() {
+        std::ostringstream out;
+        sigslot::tracing::write(out);
+        return out.str();
+    }
+
+    std::size_t occurrences(std::string const & haystack, std::string const & needle) {
+        std::size_t n = 0;
+        for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1)) ++n;
+        return n;
+    }
+}
+
+TEST(Trace, Off) {
+    sigslot::tracing::stop();
+    written();
+    Counter counter;
+    sigslot::signal<int> signal;
+    signal.connect(&counter, &Counter::slot);
+    signal(1);
+    EXPECT_EQ(counter.count, 1);
+    EXPECT_EQ(occurrences(written(), R"("ph":"X")"), 0u);
+}
+
+TEST(Trace, Emission) {
+    Counter a, b;
+    sigslot::signal<int> signal;
+    signal.instrument("trace.emission");
+    signal.connect(&a, &Counter::slot);
+    signal.connect(&b, &Counter::slot);
+    sigslot::tracing::start();
+    written();
+    signal(1);
+    sigslot::tracing::stop();
+    auto json = written();
+    EXPECT_EQ(json.find(R"({"displayTimeUnit":"ns","traceEvents":[)"), 0u);
+    EXPECT_EQ(occurrences(json, R"({"name":"trace.emission","cat":"signal","ph":"X")"), 1u);
+    EXPECT_EQ(occurrences(json, R"({"name":"trace.emission","cat":"slot","ph":"X")"), 2u);
+    EXPECT_NE(json.find(R"("name":"thread_name")"), std::string::npos);
+    // Writing empties the buffers.
+    EXPECT_EQ(occurrences(written(), R"("ph":"X")"), 0u);
+}
+
+TEST(Trace, Tasklet) {
+    sigslot::signal<int> signal;
+    auto task = waiting_task(signal);
+    task.set_name("trace \"task\"");
+    sigslot::tracing::start();
+    written();
+    task.start();
+    signal(42);
+    EXPECT_EQ(task.get(), 42);
+    sigslot::tracing::stop();
+    auto json = written();
+    // Once when started, once when resumed by the signal, and once as it finishes.
+    EXPECT_EQ(occurrences(json, R"({"name":"trace \"task\"","cat":"tasklet","ph":"X")"), 2u);
+    EXPECT_EQ(occurrences(json, R"({"name":"trace \"task\"","cat":"tasklet","ph":"i")"), 1u);
+    EXPECT_EQ(occurrences(json, R"({"name":"emit","cat":"signal","ph":"X")"), 1u);
+    // All three are identified by the coroutine's frame.
+    char id[2 * sizeof(void *) + 3];
+    std::snprintf(id, sizeof(id), "%p", task.coro.address());
+    EXPECT_EQ(occurrences(json, std::string(R"("args":{"id":")") + id + '"'), 3u);
+}
+
+TEST(Trace, Threads) {
+    Counter counter;
+    sigslot::signal<int> signal;
+    signal.connect(&counter, &Counter::slot);
+    sigslot::tracing::start();
+    written();
+    std::thread t([&signal]() { signal(1); });
+    t.join();
+    signal(1);
+    sigslot::tracing::stop();
+    auto json = written();
+    EXPECT_EQ(occurrences(json, R"({"name":"emit","cat":"signal","ph":"X")"), 2u);
+    EXPECT_GE(occurrences(json, R"("name":"thread_name")"), 2u);
+}
+
+TEST(Trace, ThreadsExit) {
+    sigslot::signal<int> signal;
+    Counter counter;
+    signal.connect(&counter, &Counter::slot);
+    sigslot::tracing::start();
+    written();
+    for (int i = 0; i != 20; ++i) {
+        std::thread t([&signal]() { signal(1); });
+        t.join();
+    }
+    sigslot::tracing::stop();
+    auto json = written();
+    EXPECT_EQ(occurrences(json, R"({"name":"emit","cat":"signal","ph":"X")"), 20u);
+    // Written out, so the exited threads' buffers are gone.
+    auto & s = sigslot::internal::_trace::tracer();
+    std::scoped_lock lock(s.mutex);
+    for (auto const & r : s.rings) EXPECT_FALSE(r->dead.load());
+}
@@ -0,0 +1,239 @@
+//
+// Created by dwd on 16/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <sigslot/sigslot.h>
+#include <sigslot/stream.h>
+#include <sigslot/tasklet.h>
+#include <sigslot/when.h>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <variant>
+
+namespace {
+    sigslot::tasklet<int> immediate(int i) {
+        co_return i;
+    }
+
+    sigslot::tasklet<int> doubled(sigslot::signal<int> & signal) {
+        co_return 2 * co_await signal;
+    }
+
+    sigslot::tasklet<int> failing(sigslot::signal<> & signal) {
+        co_await signal;
+        throw std::runtime_error("failed");
+        co_return 0;
+    }
+
+    struct freed : sigslot::tracker {
+        bool & flag;
+        explicit freed(bool & f) : flag(f) {}
+        void terminate() override {
+            flag = true;
+        }
+    };
+
+    sigslot::tasklet<int> tracked(std::shared_ptr<freed>, sigslot::signal<int> & signal) {
+        co_return co_await signal;
+    }
+
+    sigslot::tasklet<int> count_resumes(int & resumes, sigslot::signal<int> & s1, sigslot::signal<std::string const &> & s2) {
+        co_await sigslot::when_any(s1, s2);
+        ++resumes;
+        co_return resumes;
+    }
+}
+
+TEST(WhenAll, Mixed) {
+    sigslot::signal<int> s1;
+    sigslot::signal<std::string const &, int> s2;
+    sigslot::signal<> s3;
+    auto task = [](sigslot::signal<int> & s1, sigslot::signal<std::string const &, int> & s2, sigslot::signal<> & s3) -> sigslot::tasklet<int> {
+        auto [a, b, c, d] = co_await sigslot::when_all(s1, s2, s3, doubled(s1));
+        static_assert(std::is_same_v<decltype(b), std::tuple<std::string, int>>);
+        static_assert(std::is_same_v<decltype(c), std::monostate>);
+        co_return a + std::get<1>(b) + static_cast<int>(std::get<0>(b).size()) + d;
+    }(s1, s2, s3);
+    task.start();
+    s1(1);
+    EXPECT_TRUE(task.running());
+    {
+        std::string s = "four";
+        s2(s, 10);
+        s = "changed";
+    }
+    EXPECT_TRUE(task.running());
+    s3();
+    // 1 + 10 + 4 + 2 * 1
+    EXPECT_EQ(task.get(), 17);
+}
+
+TEST(WhenAll, Immediate) {
+    auto task = []() -> sigslot::tasklet<int> {
+        auto [a, b] = co_await sigslot::when_all(immediate(1), immediate(2));
+        co_return a + b;
+    }();
+    // Everything finished while starting, so it never suspended.
+    task.start();
+    EXPECT_FALSE(task.running());
+    EXPECT_EQ(task.get(), 3);
+}
+
+TEST(WhenAll, Throw) {
+    sigslot::signal<> s1;
+    sigslot::signal<int> s2;
+    auto task = [](sigslot::signal<> & s1, sigslot::signal<int> & s2) -> sigslot::tasklet<int> {
+        auto [a, b] = co_await sigslot::when_all(failing(s1), s2);
+        co_return a + b;
+    }(s1, s2);
+    task.start();
+    s1();
+    // Still waits for the rest before rethrowing.
+    EXPECT_TRUE(task.running());
+    s2(1);
+    EXPECT_THROW(task.get(), std::runtime_error);
+}
+
+TEST(WhenAny, Signals) {
+    sigslot::signal<int> s1;
+    sigslot::signal<std::string const &> s2;
+    int resumes = 0;
+    auto task = count_resumes(resumes, s1, s2);
+    task.start();
+    s2("second");
+    EXPECT_EQ(resumes, 1);
+    EXPECT_FALSE(task.running());
+    // The loser no longer waits, so the parent isn't resumed again.
+    s1(1);
+    s2("again");
+    EXPECT_EQ(resumes, 1);
+}
+
+TEST(WhenAny, Result) {
+    sigslot::signal<int> s1;
+    sigslot::signal<int> s2;
+    auto task = [](sigslot::signal<int> & s1, sigslot::signal<int> & s2) -> sigslot::tasklet<int> {
+        auto [index, value] = co_await sigslot::when_any(s1, s2);
+        EXPECT_EQ(index, value.index());
+        co_return static_cast<int>(index) * 100 + (index ? std::get<1>(value) : std::get<0>(value));
+    }(s1, s2);
+    task.start();
+    s2(7);
+    EXPECT_EQ(task.get(), 107);
+}
+
+TEST(WhenAny, Immediate) {
+    sigslot::signal<int> s1;
+    auto task = [](sigslot::signal<int> & s1) -> sigslot::tasklet<int> {
+        auto [index, value] = co_await sigslot::when_any(immediate(5), s1);
+        co_return static_cast<int>(index) * 100 + std::get<0>(value);
+    }(s1);
+    task.start();
+    EXPECT_EQ(task.get(), 5);
+    s1(1);
+}
+
+TEST(WhenAny, CancelTasklet) {
+    sigslot::signal<int> s1;
+    sigslot::signal<> s2;
+    auto child = doubled(s1);
+    auto task = [](sigslot::tasklet<int> & child, sigslot::signal<> & s2) -> sigslot::tasklet<std::size_t> {
+        auto [index, value] = co_await sigslot::when_any(child, s2);
+        co_return index;
+    }(child, s2);
+    task.start();
+    s2();
+    EXPECT_EQ(task.get(), 1u);
+    // The child carries on, but has nobody left to resume.
+    EXPECT_TRUE(child.running());
+    s1(21);
+    EXPECT_EQ(child.get(), 42);
+    // And can be awaited afresh.
+    auto again = []( sigslot::tasklet<int> & child) -> sigslot::tasklet<int> {
+        co_return co_await child;
+    }(child);
+    EXPECT_EQ(again.get(), 42);
+}
+
+TEST(WhenAny, DestroyTemporary) {
+    sigslot::signal<int> s1;
+    sigslot::signal<int> s2;
+    bool destroyed = false;
+    auto task = [](std::shared_ptr<freed> f, sigslot::signal<int> & s1, sigslot::signal<int> & s2) -> sigslot::tasklet<std::size_t> {
+        auto [index, value] = co_await sigslot::when_any(tracked(std::move(f), s1), s2);
+        co_return index;
+    }(sigslot::track<freed>(destroyed), s1, s2);
+    task.start();
+    EXPECT_FALSE(destroyed);
+    s2(1);
+    EXPECT_EQ(task.get(), 1u);
+    // The losing tasklet was handed over, so it's gone, and stopped waiting on s1.
+    EXPECT_TRUE(destroyed);
+    s1(1);
+}
+
+TEST(WhenAny, Stream) {
+    sigslot::signal<int> events;
+    sigslot::signal<> timeout;
+    auto stream = events.stream(4);
+    events(3);
+    auto task = [](sigslot::basic_signal_stream<sigslot::multi_threaded_local, int> & stream, sigslot::signal<> & timeout) -> sigslot::tasklet<int> {
+        int total = 0;
+        for (;;) {
+            auto [index, value] = co_await sigslot::when_any(stream.next(), timeout);
+            if (index == 1) break;
+            total += **std::get_if<0>(&value);
+        }
+        co_return total;
+    }(stream, timeout);
+    task.start();
+    events(4);
+    timeout();
+    EXPECT_EQ(task.get(), 7);
+}
+
+TEST(WhenAny, Abandoned) {
+    sigslot::signal<int> s1;
+    sigslot::signal<int> s2;
+    {
+        auto task = [](sigslot::signal<int> & s1, sigslot::signal<int> & s2) -> sigslot::tasklet<std::size_t> {
+            auto [index, value] = co_await sigslot::when_any(s1, s2);
+            co_return index;
+        }(s1, s2);
+        task.start();
+    }
+    // Destroying the parent cancelled both.
+    s1(1);
+    s2(2);
+}
+
+TEST(WhenAny, TwoThreads) {
+    // Both children finish at once, on threads of their own; the parent must only resume
+    // once, after the loser has either been cancelled or finished too.
+    for (int i = 0; i != 500; ++i) {
+        sigslot::signal<int> s1;
+        sigslot::signal<int> s2;
+        auto task = [](sigslot::signal<int> & s1, sigslot::signal<int> & s2) -> sigslot::tasklet<int> {
+            auto [index, value] = co_await sigslot::when_any(s1, s2);
+            co_return std::visit([](int v) { return v; }, value) == static_cast<int>(index) + 1 ? static_cast<int>(index) : -1;
+        }(s1, s2);
+        task.start();
+        std::atomic<int> ready{0};
+        auto emit = [&ready](sigslot::signal<int> & s, int v) {
+            ready.fetch_add(1);
+            while (ready.load() != 2) std::this_thread::yield();
+            s(v);
+        };
+        std::thread t1(emit, std::ref(s1), 1);
+        std::thread t2(emit, std::ref(s2), 2);
+        t1.join();
+        t2.join();
+        auto index = task.get();
+        EXPECT_TRUE(index == 0 || index == 1);
+    }
+}